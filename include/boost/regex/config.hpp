@@ -440,6 +440,37 @@ BOOST_REGEX_DECL void BOOST_REGEX_CALL reset_stack_guard_page();
 #  ifndef BOOST_REGEX_MAX_CACHE_BLOCKS
 #     define BOOST_REGEX_MAX_CACHE_BLOCKS 16
 #  endif
+#  ifndef BOOST_REGEX_MAX_THREAD_CACHE_BLOCKS
+#     define BOOST_REGEX_MAX_THREAD_CACHE_BLOCKS 4
+#  endif
+#endif
+
+/*****************************************************************************
+ *
+ *  Lazy DFA.
+ *
+ ****************************************************************************/
+
+#ifndef BOOST_REGEX_DFA_MAX_STATES
+#  define BOOST_REGEX_DFA_MAX_STATES 2000
+#endif
+
+/*****************************************************************************
+ *
+ *  Vectorised searching.
+ *  SSE2 is always available on x86-64, wider instruction sets are only
+ *  used after checking the CPU at runtime, which needs GCC-style
+ *  target attributes.
+ *
+ ****************************************************************************/
+
+#if !defined(BOOST_REGEX_NO_SIMD)
+#  if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#     define BOOST_REGEX_HAS_SSE2
+#  endif
+#  if defined(BOOST_REGEX_HAS_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__INTEL_COMPILER)
+#     define BOOST_REGEX_HAS_SIMD_DISPATCH
+#  endif
 #endif
 
 
@@ -83,6 +83,29 @@
 // if you don't want boost.regex to cache memory.
 // #define BOOST_REGEX_MAX_CACHE_BLOCKS 16
 
+// define this if you want to set the maximum number of memory blocks
+// cached by each thread in front of the cache above: Normally this is 4,
+// 0 makes every thread go straight to the shared cache.
+// #define BOOST_REGEX_MAX_THREAD_CACHE_BLOCKS 4
+
+// define this if you want get_regex_mem_block_statistics() to report
+// how often memory blocks are found in the caches (this costs a shared
+// counter update on every match):
+// #define BOOST_REGEX_MEM_BLOCK_STATISTICS
+
+// define this if you want to set the maximum number of states cached
+// by each lazy DFA used by match_dfa searches.
+// #define BOOST_REGEX_DFA_MAX_STATES 2000
+
+// define this if you want searches which become too complex to
+// backtrack through to be finished by the Pike VM used by match_linear,
+// rather than throwing, whenever the expression is one it can run:
+// #define BOOST_REGEX_LINEAR_FALLBACK
+
+// define this if you don't want the library to use SSE2/SSSE3/AVX2
+// instructions when searching for the start of a match:
+// #define BOOST_REGEX_NO_SIMD
+
 // define this if you want to be able to access extended capture
 // information in your sub_match's (caution this will slow things
 // down quite a bit).
@@ -148,6 +148,17 @@ public:
       name t(h, 0);
       return std::equal_range(m_sub_names.begin(), m_sub_names.end(), t);
    }
+   //
+   // private interface, used when saving and loading compiled expressions:
+   //
+   const std::vector<name>& get_names()const
+   {
+      return m_sub_names;
+   }
+   std::vector<name>& get_names()
+   {
+      return m_sub_names;
+   }
 private:
    std::vector<name> m_sub_names;
 };
@@ -167,12 +178,14 @@ struct regex_data : public named_subexpressions
       : m_ptraits(t), m_flags(0), m_status(0), m_expression(0), m_expression_len(0),
          m_mark_count(0), m_first_state(0), m_restart_type(0),
          m_startmap{ 0 },
-         m_can_be_null(0), m_word_mask(0), m_has_recursions(false), m_disable_match_any(false) {}
+         m_can_be_null(0), m_word_mask(0), m_has_recursions(false), m_disable_match_any(false),
+         m_required_offset((std::numeric_limits<std::size_t>::max)()), m_raw_chars(false) {}
    regex_data() 
       : m_ptraits(new ::boost::regex_traits_wrapper<traits>()), m_flags(0), m_status(0), m_expression(0), m_expression_len(0), 
          m_mark_count(0), m_first_state(0), m_restart_type(0), 
       m_startmap{ 0 },
-         m_can_be_null(0), m_word_mask(0), m_has_recursions(false), m_disable_match_any(false) {}
+         m_can_be_null(0), m_word_mask(0), m_has_recursions(false), m_disable_match_any(false),
+         m_required_offset((std::numeric_limits<std::size_t>::max)()), m_raw_chars(false) {}
 
    ::std::shared_ptr<
       ::boost::regex_traits_wrapper<traits>
@@ -193,6 +206,13 @@ struct regex_data : public named_subexpressions
       std::size_t, std::size_t> > m_subs;                 // Position of sub-expressions within the *string*.
    bool                        m_has_recursions;          // whether we have recursive expressions;
    bool                        m_disable_match_any;       // when set we need to disable the match_any flag as it causes different/buggy behaviour.
+   BOOST_REGEX_DETAIL_NS::literal_search<charT> m_prefix; // literal prefix of every match, used by restart_lit searches.
+   BOOST_REGEX_DETAIL_NS::startmap_search m_startmap_search; // block-at-a-time search for narrow characters in m_startmap.
+   BOOST_REGEX_DETAIL_NS::literal_search<charT> m_required; // a literal which every match must contain.
+   std::size_t                 m_required_offset;         // the furthest m_required can start from the start of a match, or max() if unbounded.
+   bool                        m_raw_chars;               // whether translation without icase leaves every narrow character unchanged.
+   BOOST_REGEX_DETAIL_NS::lazy_dfa_pool<charT, traits> m_dfa; // lazily built DFA's, used by match_dfa.
+   BOOST_REGEX_DETAIL_NS::pike_vm_pool                m_pike_vms; // spare Pike VM's, used by match_linear.
 };
 //
 // class basic_regex_implementation
@@ -273,6 +293,15 @@ public:
    {
       return this->m_mark_count - 1;
    }
+   size_type  memory_usage()const
+   {
+      // everything we own, except for the traits object which is shared, and
+      // the machines that match_dfa and match_linear build when first used:
+      return sizeof(*this) + this->m_data.capacity()
+         + this->m_subs.capacity() * sizeof(std::pair<std::size_t, std::size_t>)
+         + this->get_names().capacity() * sizeof(named_subexpressions::name)
+         + this->m_prefix.memory_usage() + this->m_required.memory_usage();
+   }
    const BOOST_REGEX_DETAIL_NS::re_syntax_base* get_first_state()const
    {
       return this->m_first_state;
@@ -515,6 +544,13 @@ public:
    { 
       return (m_pimpl.get() ? m_pimpl->mark_count() : 0); 
    }
+   //
+   // memory_usage: bytes held by the compiled expression, which
+   // copies of this object share:
+   size_type  memory_usage()const
+   {
+      return (m_pimpl.get() ? m_pimpl->memory_usage() : 0);
+   }
 
    int status()const
    {
@@ -618,6 +654,14 @@ public:
    {
       return m_pimpl;
    }
+   const std::shared_ptr<BOOST_REGEX_DETAIL_NS::basic_regex_implementation<charT, traits> >& get_implementation()const
+   {
+      return m_pimpl;
+   }
+   void set_implementation(std::shared_ptr<BOOST_REGEX_DETAIL_NS::basic_regex_implementation<charT, traits> > p)
+   {
+      p.swap(m_pimpl);
+   }
 
 private:
    std::shared_ptr<BOOST_REGEX_DETAIL_NS::basic_regex_implementation<charT, traits> > m_pimpl;
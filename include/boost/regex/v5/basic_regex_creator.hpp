@@ -236,6 +236,8 @@ protected:
    std::uintmax_t                m_bad_repeats;        // bitmask of repeats we can't deduce a startmap for;
    bool                          m_has_recursions;     // set when we have recursive expressions to fixup
    std::vector<unsigned char>    m_recursion_checks;   // notes which recursions we've followed while analysing this expression
+   const re_alt*                 m_map_state;          // the state whose maps create_startmaps is building
+   const unsigned char*          m_map_bytes;          // and those maps so far, before they're packed into the state
    typename traits::char_class_type m_word_mask;       // mask used to determine if a character is a word character
    typename traits::char_class_type m_mask_space;      // mask used to determine if a character is a word character
    typename traits::char_class_type m_lower_mask;       // mask used to determine if a character is a lowercase character
@@ -251,17 +253,24 @@ private:
    int calculate_backstep(re_syntax_base* state);
    void create_startmap(re_syntax_base* state, unsigned char* l_map, unsigned int* pnull, unsigned char mask);
    unsigned get_restart_type(re_syntax_base* state);
+   unsigned create_literal_prefix(re_syntax_base* state);
+   void create_required_literal(re_syntax_base* state);
+   bool is_raw_literal(bool icase);
    void set_all_masks(unsigned char* bits, unsigned char);
    bool is_bad_repeat(re_syntax_base* pt);
    void set_bad_repeat(re_syntax_base* pt);
    syntax_element_type get_repeat_type(re_syntax_base* state);
    void probe_leading_repeat(re_syntax_base* state);
+   void probe_following_literals(re_syntax_base* state);
+   void probe_possessive_repeats(re_syntax_base* state);
+   bool test_map(const re_alt* state, unsigned char c, unsigned char mask);
+   bool is_repeat_member(const re_repeat* rep, unsigned char c, bool icase);
 };
 
 template <class charT, class traits>
 basic_regex_creator<charT, traits>::basic_regex_creator(regex_data<charT, traits>* data)
    : m_pdata(data), m_traits(*(data->m_ptraits)), m_last_state(0), m_icase(false), m_repeater_id(0), 
-   m_has_backrefs(false), m_bad_repeats(0), m_has_recursions(false), m_word_mask(0), m_mask_space(0), m_lower_mask(0), m_upper_mask(0), m_alpha_mask(0)
+   m_has_backrefs(false), m_bad_repeats(0), m_has_recursions(false), m_map_state(0), m_map_bytes(0), m_word_mask(0), m_mask_space(0), m_lower_mask(0), m_upper_mask(0), m_alpha_mask(0)
 {
    m_pdata->m_data.clear();
    m_pdata->m_status = ::boost::regex_constants::error_ok;
@@ -525,7 +534,7 @@ re_syntax_base* basic_regex_creator<charT, traits>::append_set(
 
    re_set* result = static_cast<re_set*>(append_state(syntax_element_set, sizeof(re_set)));
    bool negate = char_set.is_negated();
-   std::memset(result->_map, 0, sizeof(result->_map));
+   result->_map.clear();
    //
    // handle singles first:
    //
@@ -539,7 +548,7 @@ re_syntax_base* basic_regex_creator<charT, traits>::append_set(
       {
          if(this->m_traits.translate(static_cast<charT>(i), this->m_icase)
             == this->m_traits.translate(sfirst->first, this->m_icase))
-            result->_map[i] = true;
+            result->_map.set(static_cast<unsigned char>(i));
       }
       ++sfirst;
    }
@@ -574,7 +583,7 @@ re_syntax_base* basic_regex_creator<charT, traits>::append_set(
             c3[0] = static_cast<charT>(i);
             string_type s3 = this->m_traits.transform(c3, c3 +1);
             if((s1 <= s3) && (s3 <= s2))
-               result->_map[i] = true;
+               result->_map.set(static_cast<unsigned char>(i));
          }
       }
       else
@@ -585,7 +594,8 @@ re_syntax_base* basic_regex_creator<charT, traits>::append_set(
             return 0;
          }
          // everything in range matches:
-         std::memset(result->_map + static_cast<unsigned char>(c1), true, static_cast<unsigned char>(1u) + static_cast<unsigned char>(static_cast<unsigned char>(c2) - static_cast<unsigned char>(c1)));
+         for(unsigned i = static_cast<unsigned char>(c1); i <= static_cast<unsigned char>(c2); ++i)
+            result->_map.set(static_cast<unsigned char>(i));
       }
    }
    //
@@ -604,7 +614,7 @@ re_syntax_base* basic_regex_creator<charT, traits>::append_set(
       for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
       {
          if(this->m_traits.isctype(static_cast<charT>(i), m))
-            result->_map[i] = true;
+            result->_map.set(static_cast<unsigned char>(i));
       }
    }
    //
@@ -622,7 +632,7 @@ re_syntax_base* basic_regex_creator<charT, traits>::append_set(
       for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
       {
          if(0 == this->m_traits.isctype(static_cast<charT>(i), m))
-            result->_map[i] = true;
+            result->_map.set(static_cast<unsigned char>(i));
       }
    }
    //
@@ -642,17 +652,20 @@ re_syntax_base* basic_regex_creator<charT, traits>::append_set(
          charT c[2] = { (static_cast<charT>(i)), charT(0), };
          string_type s2 = this->m_traits.transform_primary(c, c+1);
          if(s == s2)
-            result->_map[i] = true;
+            result->_map.set(static_cast<unsigned char>(i));
       }
       ++sfirst;
    }
    if(negate)
-   {
-      for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
-      {
-         result->_map[i] = !(result->_map[i]);
-      }
-   }
+      result->_map.flip();
+   //
+   // and finally the tables for repeats of the set, which look at
+   // characters before they're translated:
+   //
+   unsigned char member[1u << CHAR_BIT];
+   for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
+      member[i] = result->_map.test(static_cast<unsigned char>(this->m_traits.translate(static_cast<charT>(i), this->m_icase)));
+   result->_span.assign(member, this->m_icase);
    return result;
 }
 
@@ -689,6 +702,8 @@ void basic_regex_creator<charT, traits>::finalize(const charT* p1, const charT*
       m_pdata->m_has_recursions = false;
    // create nested startmaps:
    create_startmaps(m_pdata->m_first_state);
+   // stop repeats which can't give anything back from saving state:
+   probe_possessive_repeats(m_pdata->m_first_state);
    // create main startmap:
    std::memset(m_pdata->m_startmap, 0, sizeof(m_pdata->m_startmap));
    m_pdata->m_can_be_null = 0;
@@ -697,10 +712,21 @@ void basic_regex_creator<charT, traits>::finalize(const charT* p1, const charT*
    if(m_has_recursions)
       m_recursion_checks.assign(1 + m_pdata->m_mark_count, 0u);
    create_startmap(m_pdata->m_first_state, m_pdata->m_startmap, &(m_pdata->m_can_be_null), mask_all);
+   m_pdata->m_startmap_search.assign(m_pdata->m_startmap, static_cast<unsigned char>(mask_any));
    // get the restart type:
    m_pdata->m_restart_type = get_restart_type(m_pdata->m_first_state);
+   // see if we can search for a literal prefix instead:
+   if(m_pdata->m_restart_type == regbase::restart_any)
+      m_pdata->m_restart_type = create_literal_prefix(m_pdata->m_first_state);
+   // find a literal that every match has to contain:
+   if(m_pdata->m_restart_type != regbase::restart_fixed_lit)
+      create_required_literal(m_pdata->m_first_state);
+   // see if single character repeats can compare characters without translating them:
+   m_pdata->m_raw_chars = is_raw_literal(false);
    // optimise a leading repeat if there is one:
    probe_leading_repeat(m_pdata->m_first_state);
+   // let single character repeats back up straight to the literal after them:
+   probe_following_literals(m_pdata->m_first_state);
 }
 
 template <class charT, class traits>
@@ -726,7 +752,8 @@ void basic_regex_creator<charT, traits>::fixup_pointers(re_syntax_base* state)
          static_cast<re_repeat*>(state)->state_id = m_repeater_id++;
          BOOST_REGEX_FALLTHROUGH;
       case syntax_element_alt:
-         std::memset(static_cast<re_alt*>(state)->_map, 0, sizeof(static_cast<re_alt*>(state)->_map));
+         static_cast<re_alt*>(state)->_take_map.clear();
+         static_cast<re_alt*>(state)->_skip_map.clear();
          static_cast<re_alt*>(state)->can_be_null = 0;
          BOOST_REGEX_FALLTHROUGH;
       case syntax_element_jump:
@@ -955,12 +982,21 @@ void basic_regex_creator<charT, traits>::create_startmaps(re_syntax_base* state)
 
       // Build maps:
       m_bad_repeats = 0;
-      create_startmap(state->next.p, static_cast<re_alt*>(state)->_map, &static_cast<re_alt*>(state)->can_be_null, mask_take);
+      unsigned char l_map[1u << CHAR_BIT] = { 0 };
+      m_map_state = static_cast<re_alt*>(state);
+      m_map_bytes = l_map;
+      create_startmap(state->next.p, l_map, &static_cast<re_alt*>(state)->can_be_null, mask_take);
       m_bad_repeats = 0;
 
       if(m_has_recursions)
          m_recursion_checks.assign(1 + m_pdata->m_mark_count, 0u);
-      create_startmap(static_cast<re_alt*>(state)->alt.p, static_cast<re_alt*>(state)->_map, &static_cast<re_alt*>(state)->can_be_null, mask_skip);
+      create_startmap(static_cast<re_alt*>(state)->alt.p, l_map, &static_cast<re_alt*>(state)->can_be_null, mask_skip);
+      // and pack the results into the state:
+      static_cast<re_alt*>(state)->_take_map.assign(l_map, mask_take);
+      static_cast<re_alt*>(state)->_skip_map.assign(l_map, mask_skip);
+      static_cast<re_alt*>(state)->can_be_null |= (l_map[0] & mask_init);
+      m_map_state = 0;
+      m_map_bytes = 0;
       // adjust the type of the state to allow for faster matching:
       state->type = this->get_repeat_type(state);
    }
@@ -968,6 +1004,21 @@ void basic_regex_creator<charT, traits>::create_startmaps(re_syntax_base* state)
    m_icase = l_icase;
 }
 
+template <class charT, class traits>
+bool basic_regex_creator<charT, traits>::test_map(const re_alt* state, unsigned char c, unsigned char mask)
+{
+   //
+   // Equivalent to map[c] & mask for the byte map that create_startmap
+   // built for state: once packed, mask_init lives on in can_be_null,
+   // but the map still being built isn't in the state yet:
+   //
+   if(state == m_map_state)
+      return (m_map_bytes[c] & mask) != 0;
+   if((mask & mask_init) && !c && (state->can_be_null & mask_init))
+      return true;
+   return ((mask & mask_take) && state->_take_map.test(c)) || ((mask & mask_skip) && state->_skip_map.test(c));
+}
+
 template <class charT, class traits>
 int basic_regex_creator<charT, traits>::calculate_backstep(re_syntax_base* state)
 {
@@ -1241,8 +1292,8 @@ void basic_regex_creator<charT, traits>::create_startmap(re_syntax_base* state,
             l_map[0] |= mask_init;
             for(unsigned int i = 0; i < (1u << CHAR_BIT); ++i)
             {
-               if(static_cast<re_set*>(state)->_map[
-                  static_cast<unsigned char>(m_traits.translate(static_cast<charT>(i), l_icase))])
+               if(static_cast<re_set*>(state)->_map.test(
+                  static_cast<unsigned char>(m_traits.translate(static_cast<charT>(i), l_icase))))
                   l_map[i] |= mask;
             }
          }
@@ -1260,21 +1311,29 @@ void basic_regex_creator<charT, traits>::create_startmap(re_syntax_base* state,
       case syntax_element_long_set_rep:
          {
             re_alt* rep = static_cast<re_alt*>(state);
-            if(rep->_map[0] & mask_init)
+            if(test_map(rep, 0, mask_init))
             {
+               //
+               // A single character repeat with a non-zero minimum must be
+               // taken at least once, so whatever follows it can't start a match:
+               //
+               unsigned char rep_mask = mask_any;
+               if((state->type != syntax_element_alt) && (state->type != syntax_element_rep)
+                  && (static_cast<re_repeat*>(state)->min != 0))
+                  rep_mask = mask_take;
                if(l_map)
                {
                   // copy previous results:
                   l_map[0] |= mask_init;
                   for(unsigned int i = 0; i <= UCHAR_MAX; ++i)
                   {
-                     if(rep->_map[i] & mask_any)
+                     if(test_map(rep, static_cast<unsigned char>(i), rep_mask))
                         l_map[i] |= mask;
                   }
                }
                if(pnull)
                {
-                  if(rep->can_be_null & mask_any)
+                  if(rep->can_be_null & rep_mask)
                      *pnull |= mask;
                }
             }
@@ -1409,6 +1468,210 @@ unsigned basic_regex_creator<charT, traits>::get_restart_type(re_syntax_base* st
    return regbase::restart_any;
 }
 
+template <class charT, class traits>
+unsigned basic_regex_creator<charT, traits>::create_literal_prefix(re_syntax_base* state)
+{
+   //
+   // See whether every match has to begin with the same literal string,
+   // if it does then we can search for that string directly rather than
+   // trying each position that passes the start map.  We follow the
+   // case sensitivity exactly as the matcher would: braces and case
+   // toggles may change it, and the prefix must all have the same case:
+   //
+   std::vector<charT> prefix;
+   bool l_icase = m_pdata->m_flags & regex_constants::icase;
+   bool prefix_icase = l_icase;
+   m_pdata->m_prefix.clear();
+   while(state)
+   {
+      switch(state->type)
+      {
+      case syntax_element_startmark:
+      case syntax_element_endmark:
+         if(static_cast<re_brace*>(state)->index < 0)
+            break;
+         l_icase = static_cast<re_brace*>(state)->icase;
+         state = state->next.p;
+         continue;
+      case syntax_element_toggle_case:
+         l_icase = static_cast<re_case*>(state)->icase;
+         state = state->next.p;
+         continue;
+      case syntax_element_literal:
+         {
+            if(prefix.size() && (l_icase != prefix_icase))
+               break;
+            prefix_icase = l_icase;
+            const charT* p = static_cast<const charT*>(static_cast<const void*>(static_cast<re_literal*>(state) + 1));
+            prefix.insert(prefix.end(), p, p + static_cast<re_literal*>(state)->length);
+            state = state->next.p;
+            continue;
+         }
+      default:
+         break;
+      }
+      break;
+   }
+   //
+   // A single character is no better than the start map:
+   //
+   if(prefix.size() < 2)
+      return regbase::restart_any;
+   m_pdata->m_prefix.assign(&prefix[0], &prefix[0] + prefix.size(), prefix_icase, is_raw_literal(prefix_icase));
+   // If nothing follows the literal then the whole expression is fixed:
+   return (state && (state->type == syntax_element_match)) ? regbase::restart_fixed_lit : regbase::restart_lit;
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::create_required_literal(re_syntax_base* state)
+{
+   //
+   // Find the longest literal string that every match has to contain,
+   // along with the furthest its start can be from the start of the match.
+   // We follow only the states that every match must pass through, and
+   // stop as soon as we reach anything that branches or which might end
+   // the match early.  Literals at the very start of the expression are
+   // left to the start map and prefix searches:
+   //
+   typedef typename traits::char_class_type m_type;
+   static const std::size_t unbounded = (std::numeric_limits<std::size_t>::max)();
+   std::vector<charT> run, best;
+   bool l_icase = m_pdata->m_flags & regex_constants::icase;
+   bool run_icase = l_icase;
+   bool best_icase = l_icase;
+   std::size_t offset = 0;
+   std::size_t run_offset = 0;
+   std::size_t best_offset = 0;
+   m_pdata->m_required.clear();
+   m_pdata->m_required_offset = unbounded;
+   while(state)
+   {
+      switch(state->type)
+      {
+      case syntax_element_literal:
+         {
+            if(run.size() && (l_icase != run_icase))
+            {
+               if((run.size() > best.size()) && run_offset)
+               {
+                  best.swap(run);
+                  best_icase = run_icase;
+                  best_offset = run_offset;
+               }
+               run.clear();
+            }
+            if(run.empty())
+            {
+               run_icase = l_icase;
+               run_offset = offset;
+            }
+            unsigned len = static_cast<re_literal*>(state)->length;
+            const charT* p = static_cast<const charT*>(static_cast<const void*>(static_cast<re_literal*>(state) + 1));
+            run.insert(run.end(), p, p + len);
+            if(offset != unbounded)
+               offset += len;
+            state = state->next.p;
+            continue;
+         }
+      case syntax_element_startmark:
+      case syntax_element_endmark:
+         if(static_cast<re_brace*>(state)->index >= 0)
+         {
+            // doesn't interrupt a run of literals:
+            l_icase = static_cast<re_brace*>(state)->icase;
+            state = state->next.p;
+            continue;
+         }
+         break;
+      case syntax_element_toggle_case:
+         l_icase = static_cast<re_case*>(state)->icase;
+         state = state->next.p;
+         continue;
+      default:
+         break;
+      }
+      //
+      // Anything else ends the current run of literals:
+      //
+      if((run.size() > best.size()) && run_offset)
+      {
+         best.swap(run);
+         best_icase = run_icase;
+         best_offset = run_offset;
+      }
+      run.clear();
+      switch(state->type)
+      {
+      case syntax_element_start_line:
+      case syntax_element_end_line:
+      case syntax_element_word_boundary:
+      case syntax_element_within_word:
+      case syntax_element_word_start:
+      case syntax_element_word_end:
+      case syntax_element_buffer_start:
+      case syntax_element_buffer_end:
+      case syntax_element_soft_buffer_end:
+      case syntax_element_restart_continue:
+         state = state->next.p;
+         break;
+      case syntax_element_wild:
+      case syntax_element_set:
+         if(offset != unbounded)
+            ++offset;
+         state = state->next.p;
+         break;
+      case syntax_element_long_set:
+         if(static_cast<re_set_long<m_type>*>(state)->singleton && (offset != unbounded))
+            ++offset;
+         else
+            offset = unbounded;
+         state = state->next.p;
+         break;
+      case syntax_element_backref:
+      case syntax_element_combining:
+         offset = unbounded;
+         state = state->next.p;
+         break;
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+      case syntax_element_rep:
+         {
+            // skip the repeat, the rest of the expression still has to match:
+            re_repeat* rep = static_cast<re_repeat*>(state);
+            if((state->type == syntax_element_rep) || (rep->max == unbounded) || (offset == unbounded)
+               || ((state->type == syntax_element_long_set_rep) && !static_cast<re_set_long<m_type>*>(rep->next.p)->singleton))
+               offset = unbounded;
+            else
+               offset += rep->max;
+            state = rep->alt.p;
+            break;
+         }
+      default:
+         state = 0;
+         break;
+      }
+   }
+   if(best.empty())
+      return;
+   m_pdata->m_required.assign(&best[0], &best[0] + best.size(), best_icase, is_raw_literal(best_icase));
+   m_pdata->m_required_offset = best_offset;
+}
+
+template <class charT, class traits>
+bool basic_regex_creator<charT, traits>::is_raw_literal(bool icase)
+{
+   //
+   // For narrow characters we can use memchr and friends when translation
+   // is a no-op:
+   //
+   bool raw = (sizeof(charT) == 1) && !icase;
+   for(unsigned i = 0; raw && (i < (1u << CHAR_BIT)); ++i)
+      raw = m_traits.translate(static_cast<charT>(i)) == static_cast<charT>(i);
+   return raw;
+}
+
 template <class charT, class traits>
 void basic_regex_creator<charT, traits>::set_all_masks(unsigned char* bits, unsigned char mask)
 {
@@ -1564,6 +1827,106 @@ void basic_regex_creator<charT, traits>::probe_leading_repeat(re_syntax_base* st
    }while(state);
 }
 
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::probe_following_literals(re_syntax_base* state)
+{
+   // find the single character repeats which are always followed by a literal,
+   // possibly after some capturing brackets which don't consume anything, unless
+   // recursions mean that the end of a bracket may jump elsewhere:
+   while(state)
+   {
+      switch(state->type)
+      {
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+         {
+            re_syntax_base* next = static_cast<re_repeat*>(state)->alt.p;
+            while(next && !m_has_recursions
+               && ((next->type == syntax_element_startmark) || (next->type == syntax_element_endmark))
+               && (static_cast<re_brace*>(next)->index > 0))
+               next = next->next.p;
+            if(next && (next->type == syntax_element_literal))
+               static_cast<re_repeat*>(state)->following_literal = getoffset(next) - getoffset(state);
+         }
+         break;
+      default:
+         break;
+      }
+      state = state->next.p;
+   }
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::probe_possessive_repeats(re_syntax_base* state)
+{
+   //
+   // A greedy single character repeat never needs to give anything back if
+   // whatever follows it can't match an empty string, and can't start with
+   // any character the repeat matches: every shorter repeat would leave the
+   // next state looking at a character it can't start with.  The maps built
+   // by create_startmaps tell us what can follow, but only for narrow
+   // characters, and recursions may return to places they don't know about:
+   //
+   if((sizeof(charT) > 1) || m_has_recursions)
+      return;
+   bool l_icase = m_icase;
+   while(state)
+   {
+      switch(state->type)
+      {
+      case syntax_element_toggle_case:
+         l_icase = static_cast<re_case*>(state)->icase;
+         break;
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+         {
+            re_repeat* rep = static_cast<re_repeat*>(state);
+            if(!rep->greedy || (rep->min == rep->max) || (rep->can_be_null & mask_skip))
+               break;
+            bool overlap = false;
+            for(unsigned int i = 0; (i < (1u << CHAR_BIT)) && !overlap; ++i)
+            {
+               if(rep->_skip_map.test(static_cast<unsigned char>(i)))
+                  overlap = is_repeat_member(rep, static_cast<unsigned char>(i), l_icase);
+            }
+            rep->possessive = !overlap;
+         }
+         break;
+      default:
+         break;
+      }
+      state = state->next.p;
+   }
+}
+
+template <class charT, class traits>
+bool basic_regex_creator<charT, traits>::is_repeat_member(const re_repeat* rep, unsigned char c, bool icase)
+{
+   // whether c may be matched by the state a single character repeat repeats:
+   charT ch = static_cast<charT>(c);
+   switch(rep->type)
+   {
+   case syntax_element_dot_rep:
+      // match_not_dot_newline and match_not_dot_null can only make the wildcard match less:
+      return !is_separator(ch) || (static_cast<const re_dot*>(rep->next.p)->mask != force_not_newline);
+   case syntax_element_char_rep:
+      return m_traits.translate(ch, icase) == *reinterpret_cast<const charT*>(static_cast<const re_literal*>(rep->next.p) + 1);
+   case syntax_element_short_set_rep:
+      return static_cast<const re_set*>(rep->next.p)->_map.test(static_cast<unsigned char>(m_traits.translate(ch, icase)));
+   case syntax_element_long_set_rep:
+      {
+         typedef typename traits::char_class_type m_type;
+         return &ch != re_is_set_member(&ch, &ch + 1, static_cast<const re_set_long<m_type>*>(rep->next.p), *m_pdata, icase);
+      }
+   default:
+      return true;
+   }
+}
+
 } // namespace BOOST_REGEX_DETAIL_NS
 
 } // namespace boost
@@ -1046,6 +1046,8 @@ bool basic_regex_parser<charT, traits>::parse_repeat(std::size_t low, std::size_
    rep->max = high;
    rep->greedy = greedy;
    rep->leading = false;
+   rep->possessive = false;
+   rep->following_literal = 0;
    // store our repeater position for later:
    std::ptrdiff_t rep_off = this->getoffset(rep);
    // and append a back jump to the repeat:
@@ -36,6 +36,7 @@
 #include <climits>
 #include <ios>
 #include <istream>
+#include <map>
 
 #ifdef BOOST_REGEX_MSVC
 #pragma warning(push)
@@ -192,6 +193,13 @@ std::locale cpp_regex_traits_base<charT>::imbue(const std::locale& l)
    return result;
 }
 
+//
+// Whether c is in any of the classes in f, defined after
+// cpp_regex_traits_implementation as it needs the extension masks:
+//
+template <class charT>
+bool cpp_regex_traits_isctype(const std::ctype<charT>& ct, charT c, std::uint_least32_t f);
+
 //
 // class cpp_regex_traits_char_layer:
 // implements methods that require specialization for narrow characters:
@@ -231,6 +239,14 @@ public:
       }
       return i->second;
    }
+   charT tolower(charT c)const
+   {
+      return this->m_pctype->tolower(c);
+   }
+   bool isctype(charT c, std::uint_least32_t f)const
+   {
+      return cpp_regex_traits_isctype(*this->m_pctype, c, f);
+   }
 
 private:
    string_type get_default_message(regex_constants::syntax_type);
@@ -343,9 +359,19 @@ public:
    {
       return m_char_map[static_cast<unsigned char>(c)];
    }
+   char tolower(char c)const
+   {
+      return m_lower_map[static_cast<unsigned char>(c)];
+   }
+   bool isctype(char c, std::uint_least32_t f)const
+   {
+      return (m_class_map[static_cast<unsigned char>(c)] & f) != 0;
+   }
 
 private:
    regex_constants::syntax_type m_char_map[1u << CHAR_BIT];
+   char m_lower_map[1u << CHAR_BIT];                 // lower case of each character
+   std::uint_least32_t m_class_map[1u << CHAR_BIT];  // every class each character is in
    void init();
 };
 
@@ -722,6 +748,58 @@ typename cpp_regex_traits_implementation<charT>::char_class_type
    return masks[state_id];
 }
 
+template <class charT>
+bool cpp_regex_traits_isctype(const std::ctype<charT>& ct, charT c, std::uint_least32_t f)
+{
+   typedef typename std::ctype<charT>::mask ctype_mask;
+
+   static const ctype_mask mask_base = 
+      static_cast<ctype_mask>(
+         std::ctype<charT>::alnum 
+         | std::ctype<charT>::alpha
+         | std::ctype<charT>::cntrl
+         | std::ctype<charT>::digit
+         | std::ctype<charT>::graph
+         | std::ctype<charT>::lower
+         | std::ctype<charT>::print
+         | std::ctype<charT>::punct
+         | std::ctype<charT>::space
+         | std::ctype<charT>::upper
+         | std::ctype<charT>::xdigit);
+
+   if((f & mask_base) 
+      && (ct.is(
+         static_cast<ctype_mask>(f & mask_base), c)))
+      return true;
+   else if((f & cpp_regex_traits_implementation<charT>::mask_unicode) && is_extended(c))
+      return true;
+   else if((f & cpp_regex_traits_implementation<charT>::mask_word) && (c == '_'))
+      return true;
+   else if((f & cpp_regex_traits_implementation<charT>::mask_blank) 
+      && ct.is(std::ctype<charT>::space, c)
+      && !is_separator(c))
+      return true;
+   else if((f & cpp_regex_traits_implementation<charT>::mask_vertical) 
+      && (is_separator(c) || (c == '\v')))
+      return true;
+   else if((f & cpp_regex_traits_implementation<charT>::mask_horizontal) 
+      && ct.is(std::ctype<charT>::space, c) && !is_separator(c) && (c != '\v'))
+      return true;
+#ifdef __CYGWIN__
+   //
+   // Cygwin has a buggy ctype facet, see https://www.cygwin.com/ml/cygwin/2012-08/msg00178.html:
+   //
+   else if((f & std::ctype<charT>::xdigit) == std::ctype<charT>::xdigit)
+   {
+      if((c >= 'a') && (c <= 'f'))
+         return true;
+      if((c >= 'A') && (c <= 'F'))
+         return true;
+   }
+#endif
+   return false;
+}
+
 template <class charT>
 inline std::shared_ptr<const cpp_regex_traits_implementation<charT> > create_cpp_regex_traits(const std::locale& l)
 {
@@ -766,15 +844,15 @@ public:
    }
    charT translate_nocase(charT c) const
    {
-      return m_pimpl->m_pctype->tolower(c);
+      return m_pimpl->tolower(c);
    }
    charT translate(charT c, bool icase) const
    {
-      return icase ? m_pimpl->m_pctype->tolower(c) : c;
+      return icase ? m_pimpl->tolower(c) : c;
    }
    charT tolower(charT c) const
    {
-      return m_pimpl->m_pctype->tolower(c);
+      return m_pimpl->tolower(c);
    }
    charT toupper(charT c) const
    {
@@ -798,53 +876,7 @@ public:
    }
    bool isctype(charT c, char_class_type f) const
    {
-      typedef typename std::ctype<charT>::mask ctype_mask;
-
-      static const ctype_mask mask_base = 
-         static_cast<ctype_mask>(
-            std::ctype<charT>::alnum 
-            | std::ctype<charT>::alpha
-            | std::ctype<charT>::cntrl
-            | std::ctype<charT>::digit
-            | std::ctype<charT>::graph
-            | std::ctype<charT>::lower
-            | std::ctype<charT>::print
-            | std::ctype<charT>::punct
-            | std::ctype<charT>::space
-            | std::ctype<charT>::upper
-            | std::ctype<charT>::xdigit);
-
-      if((f & mask_base) 
-         && (m_pimpl->m_pctype->is(
-            static_cast<ctype_mask>(f & mask_base), c)))
-         return true;
-      else if((f & BOOST_REGEX_DETAIL_NS::cpp_regex_traits_implementation<charT>::mask_unicode) && BOOST_REGEX_DETAIL_NS::is_extended(c))
-         return true;
-      else if((f & BOOST_REGEX_DETAIL_NS::cpp_regex_traits_implementation<charT>::mask_word) && (c == '_'))
-         return true;
-      else if((f & BOOST_REGEX_DETAIL_NS::cpp_regex_traits_implementation<charT>::mask_blank) 
-         && m_pimpl->m_pctype->is(std::ctype<charT>::space, c)
-         && !BOOST_REGEX_DETAIL_NS::is_separator(c))
-         return true;
-      else if((f & BOOST_REGEX_DETAIL_NS::cpp_regex_traits_implementation<charT>::mask_vertical) 
-         && (::boost::BOOST_REGEX_DETAIL_NS::is_separator(c) || (c == '\v')))
-         return true;
-      else if((f & BOOST_REGEX_DETAIL_NS::cpp_regex_traits_implementation<charT>::mask_horizontal) 
-         && this->isctype(c, std::ctype<charT>::space) && !this->isctype(c, BOOST_REGEX_DETAIL_NS::cpp_regex_traits_implementation<charT>::mask_vertical))
-         return true;
-#ifdef __CYGWIN__
-      //
-      // Cygwin has a buggy ctype facet, see https://www.cygwin.com/ml/cygwin/2012-08/msg00178.html:
-      //
-      else if((f & std::ctype<charT>::xdigit) == std::ctype<charT>::xdigit)
-      {
-         if((c >= 'a') && (c <= 'f'))
-            return true;
-         if((c >= 'A') && (c <= 'F'))
-            return true;
-      }
-#endif
-      return false;
+      return m_pimpl->isctype(c, f);
    }
    std::intmax_t toi(const charT*& p1, const charT* p2, int radix)const;
    int value(charT c, int radix)const
@@ -1025,6 +1057,21 @@ namespace BOOST_REGEX_DETAIL_NS {
                m_char_map[i] = regex_constants::escape_type_not_class;
          }
       } while (0xFF != i++);
+      //
+      // and the case folding and classification of every character,
+      // which saves a call to the ctype facet for each one we look at:
+      //
+      for (unsigned j = 0; j < (1u << CHAR_BIT); ++j)
+      {
+         char c = static_cast<char>(j);
+         m_lower_map[j] = this->m_pctype->tolower(c);
+         m_class_map[j] = 0;
+         for (std::uint_least32_t bit = 1; bit; bit <<= 1)
+         {
+            if (cpp_regex_traits_isctype(*this->m_pctype, c, bit))
+               m_class_map[j] |= bit;
+         }
+      }
    }
 
 } // namespace detail
@@ -22,7 +22,9 @@
 #define BOOST_REGEX_ITERATOR_CATEGORY_HPP
 
 #include <iterator>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 namespace boost{
 namespace detail{
@@ -78,6 +80,61 @@ public:
 template <class I>
 const bool is_random_access_iterator<I>::value;
 
+namespace detail{
+
+template <class I, class V>
+struct is_vector_iterator
+{
+   static const bool value = std::is_same<I, typename std::vector<V>::iterator>::value
+      || std::is_same<I, typename std::vector<V>::const_iterator>::value;
+};
+
+template <class I>
+struct is_vector_iterator<I, bool>
+{
+   // vector<bool> packs its values into bits:
+   static const bool value = false;
+};
+
+template <class I, class V>
+struct is_contiguous_imp
+{
+   static const bool value = is_vector_iterator<I, V>::value;
+};
+
+template <class I, class charT>
+struct is_contiguous_string_imp
+{
+   static const bool value = is_vector_iterator<I, charT>::value
+      || std::is_same<I, typename std::basic_string<charT>::iterator>::value
+      || std::is_same<I, typename std::basic_string<charT>::const_iterator>::value;
+};
+
+template <class I>
+struct is_contiguous_imp<I, char> : public is_contiguous_string_imp<I, char> {};
+template <class I>
+struct is_contiguous_imp<I, wchar_t> : public is_contiguous_string_imp<I, wchar_t> {};
+
+}
+
+//
+// is_contiguous_iterator<I>::value is true when I is known to refer to
+// values held one after another in memory, so that a pointer can be
+// used in its place: pointers, and the iterators of std::basic_string
+// and std::vector.
+//
+template <class I>
+struct is_contiguous_iterator
+{
+private:
+   typedef typename std::iterator_traits<I>::value_type value_type;
+public:
+   static const bool value = std::is_pointer<I>::value || detail::is_contiguous_imp<I, value_type>::value;
+};
+
+template <class I>
+const bool is_contiguous_iterator<I>::value;
+
 }
 
 #endif
@@ -0,0 +1,1385 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         lazy_dfa.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares class lazy_dfa, which locates matches of
+  *                narrow character expressions in linear time by
+  *                building DFA states from the state machine on demand.
+  */
+
+#ifndef BOOST_REGEX_V5_LAZY_DFA_HPP
+#define BOOST_REGEX_V5_LAZY_DFA_HPP
+
+#include <boost/regex/config.hpp>
+#include <boost/regex/v5/states.hpp>
+#include <boost/regex/v5/match_flags.hpp>
+#include <boost/regex/v5/regex_traits_defaults.hpp>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost{
+namespace BOOST_REGEX_DETAIL_NS{
+
+/*** enum dfa_node_type ***********************************************
+The kinds of node in a dfa_program, the program is a Thompson NFA
+built from the states of the regular expression, with the nodes
+which can be reached from any one node listed in priority order.
+***********************************************************************/
+enum dfa_node_type
+{
+   dfa_char,      // match a character in set arg, then go to next
+   dfa_dot,       // match any character allowed by the re_dot mask in arg
+   dfa_split,     // go to next, or failing that alt, as branch arg (or -1) allows
+   dfa_epsilon,   // go to next, arg is the capture slot, or -1
+   dfa_assert,    // go to next if the zero width assertion in arg holds
+   dfa_repeat,    // a repeat of group repeat arg starts here, go to next
+   dfa_loop,      // the end of a repeat of arg: go to next, or to alt if the repeat matched nothing
+   dfa_match,     // a match ends here
+   dfa_fail       // dead end
+};
+
+struct dfa_node
+{
+   unsigned type;
+   unsigned next;
+   unsigned alt;
+   int      arg;
+};
+
+/*** enum dfa_class_property ******************************************
+What the zero width assertions need to know about each class of
+characters:
+***********************************************************************/
+enum dfa_class_property
+{
+   dfa_class_separator = 1,
+   dfa_class_cr = 2,
+   dfa_class_lf = 4,
+   dfa_class_null = 8,
+   dfa_class_word = 16
+};
+
+/*** enum dfa_way ****************************************************
+Which ways a dfa_split may go.  perl_matcher only takes a branch when
+the start map says the next character can start it, the branch rows
+of a dfa_program record those start maps so that the Pike VM goes
+nowhere the backtracking matcher wouldn't.  Each row has an entry
+for each character, one for the end of the input, and the row's
+dfa_branch_flags:
+***********************************************************************/
+enum dfa_way
+{
+   dfa_way_next = 1,        // may go to next
+   dfa_way_alt = 2,         // may go to alt
+   dfa_way_alt_first = 4    // and should try alt first
+};
+
+enum dfa_branch_flags
+{
+   dfa_branch_greedy = 1,   // a greedy repeat: next repeats, alt is what follows
+   dfa_branch_single = 2    // a single character repeat, which may always stop when it can't go on
+};
+
+static const std::size_t dfa_branch_size = (1u << CHAR_BIT) + 2;
+
+enum dfa_result
+{
+   dfa_failed = -1,    // the DFA gave up, use the backtracking matcher
+   dfa_no_match = 0,
+   dfa_matched = 1
+};
+
+//
+// The longest program we're prepared to build, expressions which
+// unroll to more nodes than this are left to the backtracking matcher:
+//
+static const std::size_t dfa_max_nodes = 10000;
+
+/*** struct dfa_program ***********************************************
+The NFA that lazy_dfa simulates.  Characters are grouped into classes
+which no node, nor any assertion, can tell apart, so that the DFA
+tables need only one entry per class, plus an extra "edge" entry for
+the start or end of the input.
+***********************************************************************/
+struct dfa_program
+{
+   dfa_program() : m_start(0), m_class_count(0), m_repeat_count(0), m_has_asserts(false), m_leading_repeat(false), m_leading_greedy(false), m_classes{ 0 } {}
+
+   //
+   // Whether a zero width assertion holds between characters of class
+   // before and after, either of which may be m_class_count for the
+   // start or end of the input:
+   //
+   bool check(int type, unsigned before, unsigned after, match_flag_type f)const
+   {
+      const unsigned edge = m_class_count;
+      const bool at_start = before == edge;
+      const bool at_end = after == edge;
+      const unsigned char bprops = at_start ? 0 : m_class_props[before];
+      const unsigned char aprops = at_end ? 0 : m_class_props[after];
+      switch(type)
+      {
+      case syntax_element_start_line:
+         if(at_start)
+            return (f & regex_constants::match_not_bol) == 0;
+         if(f & regex_constants::match_single_line)
+            return false;
+         if(at_end)
+            return (bprops & dfa_class_separator) != 0;
+         return (bprops & dfa_class_separator) && !((bprops & dfa_class_cr) && (aprops & dfa_class_lf));
+      case syntax_element_end_line:
+         if(at_end)
+            return (f & regex_constants::match_not_eol) == 0;
+         if(f & regex_constants::match_single_line)
+            return false;
+         if((aprops & dfa_class_separator) == 0)
+            return false;
+         return at_start || !((bprops & dfa_class_cr) && (aprops & dfa_class_lf));
+      case syntax_element_word_boundary:
+      {
+         if(at_end && (f & regex_constants::match_not_eow))
+            return false;
+         if(at_start && (f & regex_constants::match_not_bow))
+            return false;
+         return ((aprops & dfa_class_word) != 0) != ((bprops & dfa_class_word) != 0);
+      }
+      case syntax_element_within_word:
+         if(at_start || at_end)
+            return false;
+         return ((aprops & dfa_class_word) != 0) == ((bprops & dfa_class_word) != 0);
+      case syntax_element_word_start:
+         if(at_end || ((aprops & dfa_class_word) == 0))
+            return false;
+         if(at_start)
+            return (f & regex_constants::match_not_bow) == 0;
+         return (bprops & dfa_class_word) == 0;
+      case syntax_element_word_end:
+         if(at_start || ((bprops & dfa_class_word) == 0))
+            return false;
+         if(at_end)
+            return (f & regex_constants::match_not_eow) == 0;
+         return (aprops & dfa_class_word) == 0;
+      case syntax_element_buffer_start:
+         return at_start && ((f & regex_constants::match_not_bob) == 0);
+      case syntax_element_buffer_end:
+         return at_end && ((f & regex_constants::match_not_eob) == 0);
+      default:
+         return false;
+      }
+   }
+   //
+   // Whether perl_matcher, having failed to find a match from somewhere,
+   // may move on past later starts that could match: when the repeat
+   // at the start isn't greedy it moves on to the last place that the
+   // repeat got to, even if that was as far as it could go:
+   //
+   bool skips_starts(match_flag_type f)const
+   {
+      return m_leading_repeat && (!m_leading_greedy || (f & regex_constants::match_any));
+   }
+   //
+   // Whether a dfa_char or dfa_dot node matches a character of class cls:
+   //
+   bool accepts(const dfa_node& n, unsigned cls, match_flag_type f)const
+   {
+      if(n.type == dfa_char)
+         return m_sets[n.arg * (1u << CHAR_BIT) + m_class_chars[cls]] != 0;
+      unsigned char props = m_class_props[cls];
+      const int any_mask = (f & regex_constants::match_not_dot_newline) ? test_not_newline : test_newline;
+      if((props & dfa_class_separator) && ((any_mask & n.arg) == 0))
+         return false;
+      if((props & dfa_class_null) && (f & regex_constants::match_not_dot_null))
+         return false;
+      return true;
+   }
+   //
+   // The dfa_way's that dfa_split n may go when the next character is
+   // of class cls, or at the end of the input.  Greedy repeats stop as
+   // soon as they can't go on, whatever the start map says, and when any
+   // match will do perl_matcher runs them as if they weren't greedy:
+   //
+   unsigned ways(const dfa_node& n, unsigned cls, match_flag_type f)const
+   {
+      if(n.arg < 0)
+         return dfa_way_next | dfa_way_alt;
+      const unsigned char* row = &m_branches[n.arg * dfa_branch_size];
+      const bool at_end = cls == m_class_count;
+      unsigned result = row[at_end ? (1u << CHAR_BIT) : m_class_chars[cls]];
+      const unsigned flags = row[(1u << CHAR_BIT) + 1];
+      if(flags & dfa_branch_greedy)
+      {
+         if(f & regex_constants::match_any)
+            result |= dfa_way_alt_first;
+         else if((flags & dfa_branch_single) && (at_end || (m_nodes[n.next].type == dfa_fail) || !accepts(m_nodes[n.next], cls, f)))
+            result |= dfa_way_alt;
+      }
+      return result;
+   }
+
+
+   std::vector<dfa_node>      m_nodes;          // the program
+   std::vector<unsigned char> m_sets;           // 256 entries for each set used by dfa_char
+   std::vector<unsigned char> m_branches;       // dfa_branch_size entries for each branch used by dfa_split
+   unsigned                   m_start;          // where execution starts
+   unsigned                   m_class_count;    // number of classes
+   unsigned                   m_repeat_count;   // number of group repeats, numbered by dfa_repeat and dfa_loop
+   bool                       m_has_asserts;    // whether there are any dfa_assert nodes
+   bool                       m_leading_repeat; // whether every match starts with a bounded single character repeat
+   bool                       m_leading_greedy; // whether that repeat is greedy
+   unsigned char              m_classes[1 << CHAR_BIT]; // class of each character
+   std::vector<unsigned char> m_class_chars;    // one character from each class
+   std::vector<unsigned char> m_class_props;    // dfa_class_property bits for each class
+};
+
+/*** class dfa_visits *************************************************
+Records the nodes visited while following everything reachable from a
+node without consuming a character.  Which way a dfa_loop goes depends
+on the repeats started along the path to it, so nodes other than those
+that consume a character (or match) may be visited again by a path
+which has started a different set of repeats, up to a point: past
+that overflowed() is set, as some paths have been lost, and the caller
+should give up.  Repeats are recorded as bits, so programs may have
+no more than max_repeats of them.
+***********************************************************************/
+class dfa_visits
+{
+public:
+   static const unsigned max_repeats = 64;
+
+   dfa_visits() : m_generation(0), m_overflowed(false) {}
+
+   void resize(std::size_t nodes)
+   {
+      m_marks.assign(nodes, 0);
+      m_counts.assign(nodes, 0);
+      m_paths.assign(nodes * max_paths, 0);
+      m_generation = 0;
+      m_overflowed = false;
+   }
+   void clear()
+   {
+      if(++m_generation == 0)
+      {
+         std::fill(m_marks.begin(), m_marks.end(), 0u);
+         m_generation = 1;
+      }
+      m_overflowed = false;
+   }
+   //
+   // Returns false if node has been visited already with the repeats
+   // in entered started, or has been visited too often:
+   //
+   bool visit(unsigned node, std::uint64_t entered)
+   {
+      std::uint64_t* paths = &m_paths[node * max_paths];
+      if(m_marks[node] != m_generation)
+      {
+         m_marks[node] = m_generation;
+         m_counts[node] = 1;
+         paths[0] = entered;
+         return true;
+      }
+      for(unsigned i = 0; i < m_counts[node]; ++i)
+         if(paths[i] == entered)
+            return false;
+      if(m_counts[node] == max_paths)
+      {
+         m_overflowed = true;
+         return false;
+      }
+      paths[m_counts[node]++] = entered;
+      return true;
+   }
+   bool overflowed()const
+   {
+      return m_overflowed;
+   }
+   static std::uint64_t repeat_bit(int repeat)
+   {
+      return static_cast<std::uint64_t>(1) << repeat;
+   }
+
+private:
+   static const unsigned max_paths = 4;
+
+   std::vector<unsigned>      m_marks;       // generation in which each node was first visited
+   std::vector<unsigned char> m_counts;      // number of times each node has been visited
+   std::vector<std::uint64_t> m_paths;       // repeats started on each visit to each node
+   unsigned                   m_generation;
+   bool                       m_overflowed;  // whether a node was visited too often
+};
+
+/*** class dfa_builder ************************************************
+Converts the states of an expression into a dfa_program, or fails if
+the expression uses anything that can't be simulated without
+backtracking: back references, recursion, lookaround, independent
+sub-expressions, verbs, and repeats of groups other than ?, * and +.
+***********************************************************************/
+template <class charT, class traits>
+class dfa_builder
+{
+public:
+   dfa_builder(const regex_data<charT, traits>& data, dfa_program& program)
+      : m_data(data), m_traits(*data.m_ptraits), m_program(program), m_fail(0) {}
+
+   bool build()
+   {
+      m_program.m_start = get_node(m_data.m_first_state, (m_data.m_flags & regex_constants::icase) != 0, round_first);
+      while(!m_pending.empty())
+      {
+         pending_node item = m_pending.back();
+         m_pending.pop_back();
+         if(!convert(item) || (m_program.m_nodes.size() > dfa_max_nodes))
+            return false;
+      }
+      if(m_program.m_repeat_count > dfa_visits::max_repeats)
+         return false;
+      create_classes();
+      return true;
+   }
+
+private:
+   typedef typename traits::char_class_type m_type;
+
+   //
+   // For repeats, how many times we've been round, as far as
+   // perl_matcher's repeat counter is concerned:
+   //
+   enum round_type
+   {
+      round_first,   // not yet
+      round_again,   // at least once, and the last time matched something
+      round_over     // the last time matched nothing, so the repeat is over
+   };
+
+   struct pending_node
+   {
+      const re_syntax_base* state;
+      bool                  icase;
+      round_type            round;
+      unsigned              node;
+   };
+
+   dfa_builder& operator=(const dfa_builder&);
+
+   unsigned add_node(unsigned type, unsigned next, unsigned alt, int arg)
+   {
+      dfa_node n = { type, next, alt, arg };
+      m_program.m_nodes.push_back(n);
+      return static_cast<unsigned>(m_program.m_nodes.size() - 1);
+   }
+   void set_node(unsigned i, unsigned type, unsigned next, unsigned alt, int arg)
+   {
+      dfa_node n = { type, next, alt, arg };
+      m_program.m_nodes[i] = n;
+   }
+   //
+   // Returns the node for state, queuing it for conversion if it's new:
+   //
+   unsigned get_node(const re_syntax_base* state, bool icase, round_type round)
+   {
+      std::pair<const re_syntax_base*, unsigned> key(state, (icase ? 1u : 0u) | (static_cast<unsigned>(round) << 1));
+      typename std::map<std::pair<const re_syntax_base*, unsigned>, unsigned>::const_iterator i = m_ids.find(key);
+      if(i != m_ids.end())
+         return i->second;
+      unsigned id = add_node(dfa_fail, 0, 0, 0);
+      m_ids[key] = id;
+      pending_node item = { state, icase, round, id };
+      m_pending.push_back(item);
+      return id;
+   }
+   //
+   // The dead end that branches which may only go one way use for the other:
+   //
+   unsigned fail_node()
+   {
+      if(m_fail == 0)
+         m_fail = add_node(dfa_fail, 0, 0, 0);
+      return m_fail;
+   }
+   //
+   // Adds the branch row for a dfa_split made from state, which goes
+   // take_way when perl_matcher would take the alternative or repeat
+   // and skip_way when it would skip it.  Rows are stored as strings
+   // so that identical rows are only stored once:
+   //
+   int add_branch(const re_alt* state, unsigned take_way, unsigned skip_way, unsigned flags)
+   {
+      std::string row(dfa_branch_size, '\0');
+      for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+      {
+         // a single character repeat goes on whenever the character matches:
+         unsigned ways = ((flags & dfa_branch_single) || state->_take_map.test(static_cast<unsigned char>(c))) ? take_way : 0;
+         if(state->_skip_map.test(static_cast<unsigned char>(c)))
+            ways |= skip_way;
+         row[c] = static_cast<char>(ways);
+      }
+      row[1u << CHAR_BIT] = static_cast<char>(((state->can_be_null & mask_take) ? take_way : 0) | ((state->can_be_null & mask_skip) ? skip_way : 0));
+      row[(1u << CHAR_BIT) + 1] = static_cast<char>(flags);
+      std::map<std::string, int>::const_iterator i = m_branch_ids.find(row);
+      if(i != m_branch_ids.end())
+         return i->second;
+      int id = static_cast<int>(m_branch_ids.size());
+      m_branch_ids[row] = id;
+      m_program.m_branches.insert(m_program.m_branches.end(), row.begin(), row.end());
+      return id;
+   }
+   //
+   // Sets are stored as strings of 0's and 1's so that identical sets
+   // are only stored once:
+   //
+   int add_set(const std::string& members)
+   {
+      std::map<std::string, int>::const_iterator i = m_set_ids.find(members);
+      if(i != m_set_ids.end())
+         return i->second;
+      int id = static_cast<int>(m_set_ids.size());
+      m_set_ids[members] = id;
+      for(std::size_t j = 0; j < members.size(); ++j)
+         m_program.m_sets.push_back(static_cast<unsigned char>(members[j]));
+      return id;
+   }
+   //
+   // Adds a node which matches the single character matched by state,
+   // returns false if that isn't something we can handle:
+   //
+   bool add_char(const re_syntax_base* state, bool icase, unsigned next, unsigned& result)
+   {
+      std::string members(1u << CHAR_BIT, '\0');
+      switch(state->type)
+      {
+      case syntax_element_wild:
+         result = add_node(dfa_dot, next, 0, static_cast<const re_dot*>(state)->mask);
+         return true;
+      case syntax_element_literal:
+         if(static_cast<const re_literal*>(state)->length != 1)
+            return false;
+         result = add_node(dfa_char, next, 0, literal_set(*reinterpret_cast<const charT*>(static_cast<const re_literal*>(state) + 1), icase));
+         return true;
+      case syntax_element_set:
+      {
+         const re_bitmap& map = static_cast<const re_set*>(state)->_map;
+         for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+            members[c] = map.test(static_cast<unsigned char>(m_traits.translate(static_cast<charT>(c), icase))) ? 1 : 0;
+         break;
+      }
+      case syntax_element_long_set:
+      {
+         const re_set_long<m_type>* set = static_cast<const re_set_long<m_type>*>(state);
+         if(!set->singleton)
+            return false;
+         for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+         {
+            charT ch = static_cast<charT>(c);
+            members[c] = (re_is_set_member(&ch, &ch + 1, set, m_data, icase) != &ch) ? 1 : 0;
+         }
+         break;
+      }
+      default:
+         return false;
+      }
+      result = add_node(dfa_char, next, 0, add_set(members));
+      return true;
+   }
+   int repeat_id(const re_syntax_base* rep)
+   {
+      std::map<const re_syntax_base*, int>::const_iterator i = m_repeat_ids.find(rep);
+      if(i != m_repeat_ids.end())
+         return i->second;
+      int id = static_cast<int>(m_repeat_ids.size());
+      m_repeat_ids[rep] = id;
+      m_program.m_repeat_count = static_cast<unsigned>(m_repeat_ids.size());
+      return id;
+   }
+   int literal_set(charT what, bool icase)
+   {
+      std::string members(1u << CHAR_BIT, '\0');
+      for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+         members[c] = (m_traits.translate(static_cast<charT>(c), icase) == what) ? 1 : 0;
+      return add_set(members);
+   }
+   //
+   // Unrolls a repeat of a single character, the repeat must be
+   // bounded or we'd run out of nodes.  Once max characters have
+   // been matched the repeat can only stop, but whether it may still
+   // depends on the start map:
+   //
+   bool convert_char_repeat(const pending_node& item)
+   {
+      const re_repeat* rep = static_cast<const re_repeat*>(item.state);
+      const std::size_t unbounded = (std::numeric_limits<std::size_t>::max)();
+      if((rep->min > dfa_max_nodes) || ((rep->max != unbounded) && (rep->max - rep->min > dfa_max_nodes)))
+         return false;
+      if(rep->leading && (rep->max != unbounded))
+      {
+         m_program.m_leading_repeat = true;
+         m_program.m_leading_greedy = rep->greedy;
+      }
+      unsigned exit = get_node(rep->alt.p, item.icase, round_first);
+      unsigned flags = dfa_branch_single | (rep->greedy ? dfa_branch_greedy : 0);
+      int branch = add_branch(rep, rep->greedy ? dfa_way_next : dfa_way_alt, rep->greedy ? dfa_way_alt : dfa_way_next, flags);
+      unsigned current;
+      unsigned body;
+      if(rep->max == unbounded)
+      {
+         unsigned loop = add_node(dfa_fail, 0, 0, 0);
+         if(!add_char(rep->next.p, item.icase, loop, body))
+            return false;
+         set_node(loop, dfa_split, rep->greedy ? body : exit, rep->greedy ? exit : body, branch);
+         current = loop;
+      }
+      else
+      {
+         current = add_node(dfa_split, rep->greedy ? fail_node() : exit, rep->greedy ? exit : fail_node(), branch);
+         for(std::size_t i = rep->min; i < rep->max; ++i)
+         {
+            if(!add_char(rep->next.p, item.icase, current, body))
+               return false;
+            current = add_node(dfa_split, rep->greedy ? body : exit, rep->greedy ? exit : body, branch);
+         }
+      }
+      for(std::size_t i = 0; i < rep->min; ++i)
+      {
+         if(!add_char(rep->next.p, item.icase, current, body))
+            return false;
+         current = body;
+      }
+      set_node(item.node, dfa_epsilon, current, 0, -1);
+      return true;
+   }
+   //
+   // Repeats of anything else don't need counting as long as they're
+   // ?, * or +: the round tells us whether we've been round once
+   // already.  Each time round starts with a dfa_repeat node, so that
+   // dfa_loop can tell when a repeat matched nothing.  Either way the
+   // start map has to allow it, just as in perl_matcher, so there's
+   // always a branch:
+   //
+   bool convert_repeat(const pending_node& item)
+   {
+      const re_repeat* rep = static_cast<const re_repeat*>(item.state);
+      const std::size_t unbounded = (std::numeric_limits<std::size_t>::max)();
+      if((rep->min > 1) || ((rep->max != unbounded) && (rep->max > 1)))
+         return false;
+      bool can_take = (item.round == round_first) ? (rep->max != 0) : ((item.round == round_again) && (rep->max == unbounded));
+      bool can_skip = (item.round != round_first) || (rep->min == 0);
+      unsigned exit = can_skip ? get_node(rep->alt.p, item.icase, round_first) : fail_node();
+      unsigned body = can_take ? add_node(dfa_repeat, get_node(rep->next.p, item.icase, round_first), 0, repeat_id(rep)) : fail_node();
+      int branch = add_branch(rep, rep->greedy ? dfa_way_next : dfa_way_alt, rep->greedy ? dfa_way_alt : dfa_way_next, rep->greedy ? dfa_branch_greedy : 0);
+      set_node(item.node, dfa_split, rep->greedy ? body : exit, rep->greedy ? exit : body, branch);
+      return true;
+   }
+   bool convert(const pending_node& item)
+   {
+      const re_syntax_base* state = item.state;
+      switch(state->type)
+      {
+      case syntax_element_startmark:
+      case syntax_element_endmark:
+      {
+         const re_brace* brace = static_cast<const re_brace*>(state);
+         if(brace->index < 0)
+            return false;
+         unsigned next = get_node(state->next.p, brace->icase, round_first);
+         int slot = brace->index > 0 ? 2 * brace->index + (state->type == syntax_element_endmark ? 1 : 0) : -1;
+         set_node(item.node, dfa_epsilon, next, 0, slot);
+         return true;
+      }
+      case syntax_element_literal:
+      {
+         const re_literal* lit = static_cast<const re_literal*>(state);
+         const charT* what = reinterpret_cast<const charT*>(lit + 1);
+         unsigned next = get_node(state->next.p, item.icase, round_first);
+         if(lit->length == 0)
+         {
+            set_node(item.node, dfa_epsilon, next, 0, -1);
+            return true;
+         }
+         for(unsigned i = lit->length - 1; i > 0; --i)
+            next = add_node(dfa_char, next, 0, literal_set(what[i], item.icase));
+         set_node(item.node, dfa_char, next, 0, literal_set(what[0], item.icase));
+         return true;
+      }
+      case syntax_element_start_line:
+      case syntax_element_end_line:
+      case syntax_element_word_boundary:
+      case syntax_element_within_word:
+      case syntax_element_word_start:
+      case syntax_element_word_end:
+      case syntax_element_buffer_start:
+      case syntax_element_buffer_end:
+         m_program.m_has_asserts = true;
+         set_node(item.node, dfa_assert, get_node(state->next.p, item.icase, round_first), 0, state->type);
+         return true;
+      case syntax_element_wild:
+      case syntax_element_set:
+      case syntax_element_long_set:
+      {
+         unsigned next = get_node(state->next.p, item.icase, round_first);
+         unsigned n;
+         if(!add_char(state, item.icase, next, n))
+            return false;
+         m_program.m_nodes[item.node] = m_program.m_nodes[n];
+         m_program.m_nodes.pop_back();
+         return true;
+      }
+      case syntax_element_match:
+         set_node(item.node, dfa_match, 0, 0, 0);
+         return true;
+      case syntax_element_fail:
+         set_node(item.node, dfa_fail, 0, 0, 0);
+         return true;
+      case syntax_element_jump:
+      {
+         const re_syntax_base* target = static_cast<const re_jump*>(state)->alt.p;
+         // the jump at the end of a repeat goes back to the repeat, with at least one repeat matched,
+         // unless that repeat matched nothing, in which case the repeat is over, as in perl_matcher:
+         if((target->type == syntax_element_rep) && (static_cast<const re_repeat*>(target)->alt.p == state->next.p))
+         {
+            unsigned again = get_node(target, item.icase, round_again);
+            set_node(item.node, dfa_loop, again, get_node(target, item.icase, round_over), repeat_id(target));
+         }
+         else
+            set_node(item.node, dfa_epsilon, get_node(target, item.icase, round_first), 0, -1);
+         return true;
+      }
+      case syntax_element_alt:
+      {
+         unsigned next = get_node(state->next.p, item.icase, round_first);
+         unsigned alt = get_node(static_cast<const re_alt*>(state)->alt.p, item.icase, round_first);
+         set_node(item.node, dfa_split, next, alt, add_branch(static_cast<const re_alt*>(state), dfa_way_next, dfa_way_alt, 0));
+         return true;
+      }
+      case syntax_element_toggle_case:
+      {
+         bool icase = static_cast<const re_case*>(state)->icase;
+         set_node(item.node, dfa_epsilon, get_node(state->next.p, icase, round_first), 0, -1);
+         return true;
+      }
+      case syntax_element_rep:
+         return convert_repeat(item);
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+         return convert_char_repeat(item);
+      default:
+         // back references, recursion, lookaround and so on:
+         return false;
+      }
+   }
+   //
+   // Group the characters into classes that no set, no assertion and
+   // no branch can tell apart:
+   //
+   void create_classes()
+   {
+      std::map<std::string, unsigned> classes;
+      std::size_t set_count = m_set_ids.size();
+      std::size_t branch_count = m_branch_ids.size();
+      m_program.m_class_chars.clear();
+      m_program.m_class_props.clear();
+      for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+      {
+         charT ch = static_cast<charT>(c);
+         unsigned char props = 0;
+         if(is_separator(ch))
+            props |= dfa_class_separator;
+         if(ch == static_cast<charT>('\r'))
+            props |= dfa_class_cr;
+         if(ch == static_cast<charT>('\n'))
+            props |= dfa_class_lf;
+         if(ch == static_cast<charT>(0))
+            props |= dfa_class_null;
+         if(m_traits.isctype(ch, m_data.m_word_mask))
+            props |= dfa_class_word;
+         std::string signature(1, static_cast<char>(props));
+         for(std::size_t s = 0; s < set_count; ++s)
+            signature.append(1, static_cast<char>(m_program.m_sets[s * (1u << CHAR_BIT) + c]));
+         for(std::size_t b = 0; b < branch_count; ++b)
+            signature.append(1, static_cast<char>(m_program.m_branches[b * dfa_branch_size + c]));
+         std::map<std::string, unsigned>::const_iterator i = classes.find(signature);
+         if(i == classes.end())
+         {
+            i = classes.insert(std::make_pair(signature, static_cast<unsigned>(classes.size()))).first;
+            m_program.m_class_chars.push_back(static_cast<unsigned char>(c));
+            m_program.m_class_props.push_back(props);
+         }
+         m_program.m_classes[c] = static_cast<unsigned char>(i->second);
+      }
+      m_program.m_class_count = static_cast<unsigned>(classes.size());
+   }
+
+   const regex_data<charT, traits>&                              m_data;
+   const ::boost::regex_traits_wrapper<traits>&                  m_traits;
+   dfa_program&                                                  m_program;
+   std::vector<pending_node>                                     m_pending;   // nodes still to convert
+   std::map<std::pair<const re_syntax_base*, unsigned>, unsigned> m_ids;      // node for each state/case/round combination
+   std::map<std::string, int>                                    m_set_ids;   // index of each distinct set
+   std::map<std::string, int>                                    m_branch_ids; // index of each distinct branch row
+   std::map<const re_syntax_base*, int>                          m_repeat_ids; // index of each group repeat
+   unsigned                                                      m_fail;      // the shared dead end, or 0 if there isn't one yet
+};
+
+/*** proc reverse_dfa_program *****************************************
+Builds a program which matches the reverse of what p matches: node i
+of the result is the point just before node i of p, and the result
+finishes when it gets back to p's start.  We only ever ask whether the
+reverse program matches, not how, so priorities don't matter here, and
+a dfa_loop may as well go either way.
+***********************************************************************/
+inline void add_dfa_fan_out(dfa_program& r, const std::vector<unsigned>& targets, std::size_t pos, dfa_node& result)
+{
+   dfa_node n = { dfa_fail, 0, 0, -1 };
+   if(pos + 1 == targets.size())
+   {
+      n.type = dfa_epsilon;
+      n.next = targets[pos];
+   }
+   else if(pos < targets.size())
+   {
+      dfa_node rest;
+      add_dfa_fan_out(r, targets, pos + 1, rest);
+      r.m_nodes.push_back(rest);
+      n.type = dfa_split;
+      n.next = targets[pos];
+      n.alt = static_cast<unsigned>(r.m_nodes.size() - 1);
+   }
+   result = n;
+}
+
+inline void reverse_dfa_program(const dfa_program& p, dfa_program& r)
+{
+   const unsigned count = static_cast<unsigned>(p.m_nodes.size());
+   std::vector<std::vector<unsigned> > edges(count);
+   std::vector<unsigned> matches;
+   dfa_node blank = { dfa_fail, 0, 0, -1 };
+   r.m_nodes.assign(count, blank);
+   for(unsigned i = 0; i < count; ++i)
+   {
+      const dfa_node& n = p.m_nodes[i];
+      switch(n.type)
+      {
+      case dfa_char:
+      case dfa_dot:
+      case dfa_assert:
+      {
+         dfa_node e = { n.type, i, 0, n.arg };
+         r.m_nodes.push_back(e);
+         edges[n.next].push_back(static_cast<unsigned>(r.m_nodes.size() - 1));
+         break;
+      }
+      case dfa_split:
+      case dfa_loop:
+         edges[n.next].push_back(i);
+         edges[n.alt].push_back(i);
+         break;
+      case dfa_epsilon:
+      case dfa_repeat:
+         edges[n.next].push_back(i);
+         break;
+      case dfa_match:
+         matches.push_back(i);
+         break;
+      default:
+         break;
+      }
+   }
+   dfa_node accept = { dfa_match, 0, 0, -1 };
+   r.m_nodes.push_back(accept);
+   edges[p.m_start].push_back(static_cast<unsigned>(r.m_nodes.size() - 1));
+   for(unsigned i = 0; i < count; ++i)
+   {
+      dfa_node n;
+      add_dfa_fan_out(r, edges[i], 0, n);
+      r.m_nodes[i] = n;
+   }
+   dfa_node start;
+   add_dfa_fan_out(r, matches, 0, start);
+   r.m_nodes.push_back(start);
+   r.m_start = static_cast<unsigned>(r.m_nodes.size() - 1);
+   r.m_sets = p.m_sets;
+   r.m_class_count = p.m_class_count;
+   r.m_has_asserts = p.m_has_asserts;
+   std::memcpy(r.m_classes, p.m_classes, sizeof(r.m_classes));
+   r.m_class_chars = p.m_class_chars;
+   r.m_class_props = p.m_class_props;
+}
+
+/*** class dfa_cache **************************************************
+The DFA states built so far for one way of running a dfa_program.
+Each state is a key made up of the class of the last character seen,
+whether a match has been found yet, and the NFA nodes still running
+in priority order.  The transition out of a state on the next
+character's class is worked out the first time it's needed, and
+records whether a match ends just before that character.  When there
+are too many states the cache is thrown away and we start over, but
+if that happens too often we give up.
+***********************************************************************/
+class dfa_cache
+{
+public:
+   dfa_cache() : m_program(0), m_flags(regex_constants::match_default), m_reverse(false), m_first(false), m_anchored(false),
+      m_stride(0), m_generation(0), m_entered(0), m_flushed(false), m_flush_position(0) {}
+
+   void init(const dfa_program* p, bool reverse, bool first, bool anchored)
+   {
+      m_program = p;
+      m_reverse = reverse;
+      m_first = first;
+      m_anchored = anchored;
+      m_stride = p->m_class_count + 1;
+      m_marks.assign(p->m_nodes.size(), 0);
+      m_visits.resize(p->m_nodes.size());
+      clear();
+   }
+   //
+   // Which flags we're using changes what the states do, so we
+   // have to start again if they change:
+   //
+   void set_flags(match_flag_type f)
+   {
+      const match_flag_type used = regex_constants::match_not_bol | regex_constants::match_not_eol
+         | regex_constants::match_not_bob | regex_constants::match_not_eob | regex_constants::match_not_bow
+         | regex_constants::match_not_eow | regex_constants::match_not_dot_newline
+         | regex_constants::match_not_dot_null | regex_constants::match_single_line;
+      f &= used;
+      if(f != m_flags)
+      {
+         m_flags = f;
+         clear();
+      }
+      m_flushed = false;
+   }
+   const unsigned char* classes()const
+   {
+      return m_program->m_classes;
+   }
+   unsigned edge()const
+   {
+      return m_program->m_class_count;
+   }
+   //
+   // The row of the state we start in, given the class of the character
+   // on the far side of the starting point:
+   //
+   int start(unsigned ctx)
+   {
+      if(m_keys.size() >= BOOST_REGEX_DFA_MAX_STATES)
+         clear();
+      std::vector<unsigned> key;
+      key.push_back(m_program->m_has_asserts ? ctx : 0);
+      key.push_back(0);
+      if(m_anchored)
+         key.push_back(m_program->m_start);
+      std::map<std::vector<unsigned>, int>::const_iterator i = m_index.find(key);
+      return (i == m_index.end() ? add_state(key) : i->second) * static_cast<int>(m_stride);
+   }
+   //
+   // Transitions are (offset of the next state's row << 2) | (2 if the
+   // next state can never match) | (1 if a match ends before this
+   // character), or -1 if not yet known, in which case call compute.
+   // States are identified by the offset of their row in the table:
+   //
+   const int* table()const
+   {
+      return &m_table[0];
+   }
+   //
+   // Works out a transition, returns -1 if we've given up; "position"
+   // is how far into this search we are:
+   //
+   int compute(int row, unsigned cls, std::size_t position)
+   {
+      const std::vector<unsigned>& key = *m_keys[row / m_stride];
+      const unsigned ctx = key[0];
+      const bool matched = key[1] != 0;
+      const unsigned before = m_reverse ? cls : ctx;
+      const unsigned after = m_reverse ? ctx : cls;
+      bool hit = false;
+      m_visits.clear();
+      m_list.clear();
+      for(std::size_t i = 2; (i < key.size()) && !(hit && m_first); ++i)
+         hit = closure(key[i], before, after) || hit;
+      // unless we've found a match, a new match may start here, with the lowest priority of all:
+      if(!m_anchored && !matched && !hit)
+         hit = closure(m_program->m_start, before, after);
+      // if we lost track of some paths we can't say what matches:
+      if(m_visits.overflowed())
+         return -1;
+      if(cls == m_program->m_class_count)
+      {
+         m_table[row + cls] = hit ? 1 : 0;
+         return hit ? 1 : 0;
+      }
+      next_generation();
+      m_kernel.clear();
+      m_kernel.push_back(m_program->m_has_asserts ? cls : 0);
+      m_kernel.push_back(m_first && (matched || hit) ? 1 : 0);
+      for(std::size_t i = 0; i < m_list.size(); ++i)
+      {
+         const dfa_node& n = m_program->m_nodes[m_list[i]];
+         if(m_program->accepts(n, cls, m_flags) && (m_marks[n.next] != m_generation))
+         {
+            m_marks[n.next] = m_generation;
+            m_kernel.push_back(n.next);
+         }
+      }
+      std::map<std::vector<unsigned>, int>::const_iterator pos = m_index.find(m_kernel);
+      if(pos != m_index.end())
+         return m_table[row + cls] = transition(pos->second, hit);
+      if(m_keys.size() >= BOOST_REGEX_DFA_MAX_STATES)
+      {
+         // out of room: start again, but give up if we last did so only a little while ago:
+         if(m_flushed && (position - m_flush_position < 10 * static_cast<std::size_t>(BOOST_REGEX_DFA_MAX_STATES)))
+            return -1;
+         m_flushed = true;
+         m_flush_position = position;
+         clear();
+         return transition(add_state(m_kernel), hit);
+      }
+      int target = add_state(m_kernel);
+      return m_table[row + cls] = transition(target, hit);
+   }
+
+private:
+   void clear()
+   {
+      m_index.clear();
+      m_keys.clear();
+      m_table.clear();
+      m_dead.clear();
+   }
+   int transition(int target, bool hit)const
+   {
+      return ((target * static_cast<int>(m_stride)) << 2) | (m_dead[target] ? 2 : 0) | (hit ? 1 : 0);
+   }
+   int add_state(const std::vector<unsigned>& key)
+   {
+      int id = static_cast<int>(m_keys.size());
+      std::map<std::vector<unsigned>, int>::iterator i = m_index.insert(std::make_pair(key, id)).first;
+      m_keys.push_back(&i->first);
+      m_table.insert(m_table.end(), m_stride, -1);
+      m_dead.push_back((key.size() == 2) && (m_anchored || key[1]) ? 1 : 0);
+      return id;
+   }
+   //
+   // Adds the nodes reachable from node i to m_list in priority order,
+   // returns true if we reach a match; when looking for the first match
+   // nothing of lower priority than the match matters, so we stop there.
+   // m_entered records the repeats started along the current path, which
+   // being in the same closure can only have matched nothing so far, an
+   // entry of node count + n on the stack means "repeat n is over":
+   //
+   bool closure(unsigned i, unsigned before, unsigned after)
+   {
+      bool hit = false;
+      const unsigned count = static_cast<unsigned>(m_program->m_nodes.size());
+      m_stack.push_back(i);
+      while(!m_stack.empty())
+      {
+         i = m_stack.back();
+         m_stack.pop_back();
+         if(i >= count)
+         {
+            m_entered &= ~dfa_visits::repeat_bit(static_cast<int>(i - count));
+            continue;
+         }
+         const dfa_node& n = m_program->m_nodes[i];
+         if(!m_visits.visit(i, (n.type == dfa_char) || (n.type == dfa_dot) || (n.type == dfa_match) ? 0 : m_entered))
+            continue;
+         switch(n.type)
+         {
+         case dfa_char:
+         case dfa_dot:
+            m_list.push_back(i);
+            break;
+         case dfa_split:
+            m_stack.push_back(n.alt);
+            m_stack.push_back(n.next);
+            break;
+         case dfa_epsilon:
+            m_stack.push_back(n.next);
+            break;
+         case dfa_assert:
+            if(m_program->check(n.arg, before, after, m_flags))
+               m_stack.push_back(n.next);
+            break;
+         case dfa_repeat:
+            if((m_entered & dfa_visits::repeat_bit(n.arg)) == 0)
+            {
+               m_entered |= dfa_visits::repeat_bit(n.arg);
+               m_stack.push_back(count + n.arg);
+            }
+            m_stack.push_back(n.next);
+            break;
+         case dfa_loop:
+            m_stack.push_back(m_entered & dfa_visits::repeat_bit(n.arg) ? n.alt : n.next);
+            break;
+         case dfa_match:
+            hit = true;
+            if(m_first)
+            {
+               m_stack.clear();
+               m_entered = 0;
+               return true;
+            }
+            break;
+         default:
+            break;
+         }
+      }
+      return hit;
+   }
+   void next_generation()
+   {
+      if(++m_generation == 0)
+      {
+         std::fill(m_marks.begin(), m_marks.end(), 0u);
+         m_generation = 1;
+      }
+   }
+   const dfa_program*                     m_program;
+   match_flag_type                        m_flags;          // the flags the states were built for
+   bool                                   m_reverse;        // whether we're running backwards
+   bool                                   m_first;          // whether we want the first match or any match
+   bool                                   m_anchored;       // whether matches may only start at the start
+   unsigned                               m_stride;         // entries per state in m_table
+   std::map<std::vector<unsigned>, int>   m_index;          // state for each key
+   std::vector<const std::vector<unsigned>*> m_keys;        // key of each state
+   std::vector<int>                       m_table;          // transitions, or -1 if not yet known
+   std::vector<unsigned char>             m_dead;           // whether each state can never match
+   std::vector<unsigned>                  m_marks;          // visited marks for each node
+   unsigned                               m_generation;     // current value of m_marks
+   std::vector<unsigned>                  m_stack;          // scratch space
+   dfa_visits                             m_visits;         // nodes visited by closure()
+   std::uint64_t                          m_entered;        // repeats started on the current path of closure()
+   std::vector<unsigned>                  m_list;           // scratch space
+   std::vector<unsigned>                  m_kernel;         // scratch space
+   bool                                   m_flushed;        // whether we've thrown the cache away during this search
+   std::size_t                            m_flush_position; // how far into the search that was
+};
+
+/*** class lazy_dfa ***************************************************
+Finds where the first match starts by running the program forwards
+to find where that match ends, then the reversed program backwards
+from there to find the furthest back that a match ending there could
+start: that's the start of the first match, since no match starts
+any earlier.  Only the start is returned, as the backtracking matcher
+still has to work out exactly what matched from there.
+***********************************************************************/
+class lazy_dfa
+{
+public:
+   lazy_dfa(const dfa_program* forward, const dfa_program* reverse)
+      : m_program(forward)
+   {
+      m_first.init(forward, false, true, false);
+      m_anchored.init(forward, false, true, true);
+      m_all.init(forward, false, false, true);
+      m_reverse.init(reverse, true, false, true);
+   }
+   //
+   // Finds the start of the first match in [first, last), where
+   // backstop is the start of the whole input:
+   //
+   template <class BidiIterator>
+   int find(BidiIterator backstop, BidiIterator first, BidiIterator last, match_flag_type f, BidiIterator& start)
+   {
+      if((first == backstop) && (f & regex_constants::match_prev_avail))
+         return dfa_failed;   // \A and ^ would disagree about where the start is
+      bool anchored = (f & regex_constants::match_continuous) != 0;
+      dfa_cache& cache = anchored ? m_anchored : m_first;
+      cache.set_flags(f);
+      BidiIterator end(last);
+      int r = forward(cache, first, last, context(cache, backstop, first, f), anchored, end);
+      if((r != dfa_matched) || anchored)
+      {
+         start = first;
+         return r;
+      }
+      // the first match may not be the one perl_matcher finds:
+      if(m_program->skips_starts(f))
+         return dfa_failed;
+      m_reverse.set_flags(f);
+      return backward(backstop, first, end, last, f, start);
+   }
+   //
+   // Checks whether all of [first, last) can match:
+   //
+   template <class BidiIterator>
+   int match(BidiIterator backstop, BidiIterator first, BidiIterator last, match_flag_type f)
+   {
+      if((first == backstop) && (f & regex_constants::match_prev_avail))
+         return dfa_failed;
+      m_all.set_flags(f);
+      BidiIterator end(first);
+      int r = forward(m_all, first, last, context(m_all, backstop, first, f), false, end);
+      if((r == dfa_matched) && (end != last))
+         return dfa_no_match;
+      return r;
+   }
+
+private:
+   template <class BidiIterator>
+   static unsigned context(const dfa_cache& cache, BidiIterator backstop, BidiIterator first, match_flag_type f)
+   {
+      if((first == backstop) && ((f & regex_constants::match_prev_avail) == 0))
+         return cache.edge();
+      --first;
+      return cache.classes()[static_cast<unsigned char>(*first)];
+   }
+   //
+   // Runs forwards from first, setting end to where the match ends:
+   //
+   template <class BidiIterator>
+   static int forward(dfa_cache& cache, BidiIterator first, BidiIterator last, unsigned ctx, bool earliest, BidiIterator& end)
+   {
+      const unsigned char* classes = cache.classes();
+      bool found = false;
+      std::size_t count = 0;
+      int state = cache.start(ctx);
+      const int* table = cache.table();
+      while(first != last)
+      {
+         unsigned cls = classes[static_cast<unsigned char>(*first)];
+         int t = table[state + cls];
+         if(t < 0)
+         {
+            t = cache.compute(state, cls, count);
+            if(t < 0)
+               return dfa_failed;
+            table = cache.table();
+         }
+         if(t & 1)
+         {
+            found = true;
+            end = first;
+            if(earliest)
+               return dfa_matched;
+         }
+         state = t >> 2;
+         ++first;
+         ++count;
+         if(t & 2)
+            return found ? dfa_matched : dfa_no_match;
+      }
+      int t = table[state + cache.edge()];
+      if(t < 0)
+         t = cache.compute(state, cache.edge(), count);
+      if(t < 0)
+         return dfa_failed;
+      if(t & 1)
+      {
+         found = true;
+         end = last;
+      }
+      return found ? dfa_matched : dfa_no_match;
+   }
+   //
+   // Runs backwards from end to no further than first, setting start to
+   // the furthest back that a match ending at end can start:
+   //
+   template <class BidiIterator>
+   int backward(BidiIterator backstop, BidiIterator first, BidiIterator end, BidiIterator last, match_flag_type f, BidiIterator& start)
+   {
+      const unsigned char* classes = m_reverse.classes();
+      bool found = false;
+      std::size_t count = 0;
+      int state = m_reverse.start(end == last ? m_reverse.edge() : classes[static_cast<unsigned char>(*end)]);
+      const int* table = m_reverse.table();
+      BidiIterator position(end);
+      while(position != first)
+      {
+         BidiIterator prev(position);
+         --prev;
+         unsigned cls = classes[static_cast<unsigned char>(*prev)];
+         int t = table[state + cls];
+         if(t < 0)
+         {
+            t = m_reverse.compute(state, cls, count);
+            if(t < 0)
+               return dfa_failed;
+            table = m_reverse.table();
+         }
+         if(t & 1)
+         {
+            found = true;
+            start = position;
+         }
+         state = t >> 2;
+         position = prev;
+         ++count;
+         if(t & 2)
+            return found ? dfa_matched : dfa_failed;
+      }
+      unsigned cls = context(m_reverse, backstop, first, f);
+      int t = table[state + cls];
+      if(t < 0)
+         t = m_reverse.compute(state, cls, count);
+      if(t < 0)
+         return dfa_failed;
+      if(t & 1)
+      {
+         found = true;
+         start = first;
+      }
+      // the forward pass found a match, so not finding one here means something's wrong:
+      return found ? dfa_matched : dfa_failed;
+   }
+
+   const dfa_program* m_program;   // the forward program
+   dfa_cache m_first;     // forwards, finding the first match
+   dfa_cache m_anchored;  // forwards, finding the first match starting at the start
+   dfa_cache m_all;       // forwards, finding any match starting at the start
+   dfa_cache m_reverse;   // backwards from the end of a match
+};
+
+/*** class lazy_dfa_pool **********************************************
+Owned by each regex_data: builds the programs the first time they're
+needed, and keeps the lazy_dfa's that aren't currently in use, so that
+each search can borrow one whose caches need no locking.  Nothing is
+allocated until match_dfa or match_linear is first used, and after
+that borrowing and returning a lazy_dfa is an atomic operation apiece.
+***********************************************************************/
+template <class charT, class traits>
+class lazy_dfa_pool
+{
+public:
+   lazy_dfa_pool() : m_programs(nullptr) {}
+   ~lazy_dfa_pool()
+   {
+      delete m_programs.load();
+   }
+
+   //
+   // Returns the forward program, building it if need be, or a null
+   // pointer if the expression can't be converted:
+   //
+   const dfa_program* program(const regex_data<charT, traits>& data)const
+   {
+      const programs* p = get(data);
+      return p->usable ? &p->forward : 0;
+   }
+   lazy_dfa* acquire(const regex_data<charT, traits>& data)const
+   {
+      programs* p = get(data);
+      if(!p->usable)
+         return 0;
+      for(std::size_t i = 0; i < spare_count; ++i)
+      {
+         lazy_dfa* dfa = p->spare[i].load();
+         if(dfa && p->spare[i].compare_exchange_strong(dfa, nullptr))
+            return dfa;
+      }
+      return new lazy_dfa(&p->forward, &p->reverse);
+   }
+   void release(lazy_dfa* dfa)const
+   {
+      programs* p = m_programs.load(std::memory_order_acquire);
+      for(std::size_t i = 0; i < spare_count; ++i)
+      {
+         lazy_dfa* empty = p->spare[i].load();
+         if(!empty && p->spare[i].compare_exchange_strong(empty, dfa))
+            return;
+      }
+      delete dfa;
+   }
+
+private:
+   lazy_dfa_pool(const lazy_dfa_pool&);
+   lazy_dfa_pool& operator=(const lazy_dfa_pool&);
+
+   static const std::size_t spare_count = 8;
+
+   struct programs
+   {
+      programs() : usable(false)
+      {
+         for(std::size_t i = 0; i < spare_count; ++i)
+            spare[i].store(nullptr);
+      }
+      ~programs()
+      {
+         for(std::size_t i = 0; i < spare_count; ++i)
+            delete spare[i].load();
+      }
+      bool                    usable;              // false if the expression can't be converted
+      dfa_program             forward;
+      dfa_program             reverse;
+      std::atomic<lazy_dfa*>  spare[spare_count];  // lazy_dfa's not currently in use
+   };
+
+   programs* get(const regex_data<charT, traits>& data)const
+   {
+      programs* result = m_programs.load(std::memory_order_acquire);
+      if(result)
+         return result;
+      std::unique_ptr<programs> p(new programs());
+      dfa_builder<charT, traits> builder(data, p->forward);
+      if(builder.build())
+      {
+         reverse_dfa_program(p->forward, p->reverse);
+         p->usable = true;
+      }
+      else
+         p->forward = dfa_program();
+      // if another thread got there first, use what it built instead:
+      if(m_programs.compare_exchange_strong(result, p.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+         return p.release();
+      return result;
+   }
+
+   mutable std::atomic<programs*> m_programs;   // null until first needed
+};
+
+/*** class lazy_dfa_lease *********************************************
+Borrows a lazy_dfa from a pool for the duration of one search.
+***********************************************************************/
+template <class charT, class traits>
+class lazy_dfa_lease
+{
+public:
+   lazy_dfa_lease(const regex_data<charT, traits>& data)
+      : m_pool(data.m_dfa), m_dfa(data.m_dfa.acquire(data)) {}
+   ~lazy_dfa_lease()
+   {
+      if(m_dfa)
+         m_pool.release(m_dfa);
+   }
+   lazy_dfa* get()const
+   {
+      return m_dfa;
+   }
+private:
+   lazy_dfa_lease(const lazy_dfa_lease&);
+   lazy_dfa_lease& operator=(const lazy_dfa_lease&);
+
+   const lazy_dfa_pool<charT, traits>& m_pool;
+   lazy_dfa*                           m_dfa;
+};
+
+} // namespace BOOST_REGEX_DETAIL_NS
+} // namespace boost
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         literal_search.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares class literal_search, used to locate fixed
+  *                strings within the text being searched.
+  */
+
+#ifndef BOOST_REGEX_V5_LITERAL_SEARCH_HPP
+#define BOOST_REGEX_V5_LITERAL_SEARCH_HPP
+
+#include <boost/regex/config.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace boost{
+namespace BOOST_REGEX_DETAIL_NS{
+
+/*** class literal_search *********************************************
+Holds a string of (already translated) literal characters, plus a
+Horspool skip table so that we can find the string in the input
+quickly.  The skip table is indexed on the low byte of each
+character, so for wide characters it records the smallest shift of
+any character sharing that byte: that's conservative but still safe.
+When the string is narrow and translation is a no-op we can search
+contiguous input (pointers, and std::string or std::vector iterators)
+with memchr/memcmp instead.
+***********************************************************************/
+template <class charT>
+class literal_search
+{
+public:
+   literal_search() : m_icase(false), m_raw(false) {}
+
+   void assign(const charT* p1, const charT* p2, bool icase, bool raw)
+   {
+      m_string.assign(p1, p2);
+      m_icase = icase;
+      m_raw = raw && !icase;
+      // shifts are capped to fit in a byte, shifting less than we could is always safe:
+      m_shift.assign(1u << CHAR_BIT, static_cast<unsigned char>((std::min)(m_string.size(), static_cast<std::size_t>(UCHAR_MAX))));
+      for(std::size_t i = 0; i + 1 < m_string.size(); ++i)
+         m_shift[static_cast<unsigned char>(m_string[i])] = static_cast<unsigned char>((std::min)(m_string.size() - 1 - i, static_cast<std::size_t>(UCHAR_MAX)));
+   }
+   void clear()
+   {
+      m_string.clear();
+      m_shift.clear();
+      m_icase = false;
+      m_raw = false;
+   }
+   bool empty()const
+   {
+      return m_string.empty();
+   }
+   std::size_t size()const
+   {
+      return m_string.size();
+   }
+   // the memory held, apart from this object itself:
+   std::size_t memory_usage()const
+   {
+      return m_string.capacity() * sizeof(charT) + m_shift.capacity();
+   }
+   bool icase()const
+   {
+      return m_icase;
+   }
+   bool raw()const
+   {
+      return m_raw;
+   }
+   const charT* begin()const
+   {
+      return m_string.empty() ? 0 : &m_string[0];
+   }
+   const charT* end()const
+   {
+      return begin() + m_string.size();
+   }
+   //
+   // Returns the first position in [first, last) at which the literal
+   // occurs, or last if there is no such position:
+   //
+   template <class I, class traits>
+   I find(I first, I last, const traits& t)const
+   {
+      typedef typename std::iterator_traits<I>::iterator_category category;
+      if(m_string.empty())
+         return first;
+      if(m_raw)
+         return find_raw(first, last, t, static_cast<std::integral_constant<bool, is_byte_array<I>::value>*>(0));
+      return find(first, last, t, static_cast<category*>(0));
+   }
+private:
+   template <class I, class traits>
+   I find_raw(I first, I last, const traits&, std::integral_constant<bool, true>*)const
+   {
+      // memchr for the first character, then check the rest:
+      const std::size_t len = m_string.size();
+      if(static_cast<std::size_t>(last - first) < len)
+         return last;
+      const charT* p = &m_string[0];
+      const charT* base = reinterpret_cast<const charT*>(array_pointer(first));
+      const charT* start = base;
+      const charT* end = base + (last - first);
+      while(static_cast<std::size_t>(end - start) >= len)
+      {
+         const charT* pos = static_cast<const charT*>(std::memchr(start, static_cast<unsigned char>(*p), static_cast<std::size_t>(end - start) - len + 1));
+         if(pos == 0)
+            break;
+         if(std::memcmp(pos + 1, p + 1, len - 1) == 0)
+            return first + (pos - base);
+         start = pos + 1;
+      }
+      return last;
+   }
+   template <class I, class traits>
+   I find_raw(I first, I last, const traits& t, std::integral_constant<bool, false>*)const
+   {
+      typedef typename std::iterator_traits<I>::iterator_category category;
+      return find(first, last, t, static_cast<category*>(0));
+   }
+   template <class I, class traits>
+   I find(I first, I last, const traits& t, std::random_access_iterator_tag*)const
+   {
+      typedef typename std::iterator_traits<I>::difference_type difference_type;
+      const std::size_t len = m_string.size();
+      const charT* p = &m_string[0];
+      const charT last_char = p[len - 1];
+      while(static_cast<std::size_t>(last - first) >= len)
+      {
+         charT c = t.translate(first[len - 1], m_icase);
+         if(c == last_char)
+         {
+            std::size_t j = len - 1;
+            while(j && (t.translate(first[j - 1], m_icase) == p[j - 1]))
+               --j;
+            if(j == 0)
+               return first;
+         }
+         first += static_cast<difference_type>(m_shift[static_cast<unsigned char>(c)]);
+      }
+      return last;
+   }
+   template <class I, class traits>
+   I find(I first, I last, const traits& t, void*)const
+   {
+      const std::size_t len = m_string.size();
+      const charT* p = &m_string[0];
+      while(first != last)
+      {
+         while((first != last) && (t.translate(*first, m_icase) != p[0]))
+            ++first;
+         if(first == last)
+            break;
+         I i = first;
+         std::size_t j = 1;
+         ++i;
+         while((j < len) && (i != last) && (t.translate(*i, m_icase) == p[j]))
+         {
+            ++i;
+            ++j;
+         }
+         if(j == len)
+            return first;
+         if(i == last)
+            break;   // not enough input left for a match
+         ++first;
+      }
+      return last;
+   }
+
+   std::vector<charT>       m_string;   // the literal, translated
+   std::vector<unsigned char> m_shift;  // Horspool skip table
+   bool                     m_icase;    // whether the literal is case insensitive
+   bool                     m_raw;      // whether we can compare untranslated narrow characters directly
+};
+
+} // namespace BOOST_REGEX_DETAIL_NS
+} // namespace boost
+
+#endif
@@ -62,9 +62,9 @@ typedef enum _match_flags
    match_nosubs = match_posix << 1,                  /* don't trap marked subs */
    match_extra = match_nosubs << 1,                  /* include full capture information for repeated captures */
    match_single_line = match_extra << 1,             /* treat text as single line and ignore any \n's when matching ^ and $. */
-   match_unused1 = match_single_line << 1,           /* unused */
-   match_unused2 = match_unused1 << 1,               /* unused */
-   match_unused3 = match_unused2 << 1,               /* unused */
+   match_dfa = match_single_line << 1,               /* locate matches with a lazy DFA where possible */
+   match_linear = match_dfa << 1,                    /* match with a Pike VM, in linear time, where possible */
+   match_unused3 = match_linear << 1,                /* unused */
    match_max = match_unused3,
 
    format_perl = 0,                                  /* perl style replacement */
@@ -81,7 +81,7 @@ typedef enum _match_flags
       | match_not_dot_null | match_prev_avail | match_init | match_not_null
       | match_continuous | match_partial | match_stop | match_not_initial_null 
       | match_stop | match_all | match_perl | match_posix | match_nosubs
-      | match_extra | match_single_line | match_unused1 | match_unused2 
+      | match_extra | match_single_line | match_dfa | match_linear 
       | match_unused3 | match_max | format_perl | format_default | format_sed
       | format_all | format_no_copy | format_first_only | format_is_if
       | format_literal
@@ -136,6 +136,8 @@ using regex_constants::match_posix;
 using regex_constants::match_nosubs;
 using regex_constants::match_extra;
 using regex_constants::match_single_line;
+using regex_constants::match_dfa;
+using regex_constants::match_linear;
 /*using regex_constants::match_max; */
 using regex_constants::format_all;
 using regex_constants::format_sed;
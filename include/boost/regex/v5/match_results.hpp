@@ -511,6 +511,11 @@ public:
          m_subs[n].matched = false;
       }
    }
+   void  set_prefix_first(BidiIterator i)
+   {
+      m_subs[1].first = i;
+      m_subs[1].matched = (m_subs[1].first != m_subs[1].second);
+   }
    void  set_first(BidiIterator i, size_type pos, bool escape_k = false)
    {
       BOOST_REGEX_ASSERT(pos+2 < m_subs.size());
@@ -532,6 +537,11 @@ public:
    {
       m_named_subs = subs;
    }
+   bool  has_named_subs(const named_sub_type* subs)const
+   {
+      // lets the caller skip the reference count update when reusing results:
+      return m_named_subs.get() == subs;
+   }
 
 private:
    //
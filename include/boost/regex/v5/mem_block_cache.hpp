@@ -45,7 +45,7 @@ struct mem_block_cache
        if (cache[i].load()) ::operator delete(cache[i].load());
      }
    }
-   void* get()
+   void* get_cached()
    {
      for (size_t i = 0;i < BOOST_REGEX_MAX_CACHE_BLOCKS; ++i) {
        void* p = cache[i].load();
@@ -53,7 +53,12 @@ struct mem_block_cache
          if (cache[i].compare_exchange_strong(p, NULL)) return p;
        }
      }
-     return ::operator new(BOOST_REGEX_BLOCKSIZE);
+     return NULL;
+   }
+   void* get()
+   {
+     void* p = get_cached();
+     return p ? p : ::operator new(BOOST_REGEX_BLOCKSIZE);
    }
    void put(void* ptr)
    {
@@ -100,7 +105,7 @@ struct mem_block_cache
          ::operator delete(old);
       }
    }
-   void* get()
+   void* get_cached()
    {
 #ifdef BOOST_HAS_THREADS
       std::lock_guard<std::mutex> g(mut);
@@ -112,7 +117,12 @@ struct mem_block_cache
          --cached_blocks;
          return result;
       }
-      return ::operator new(BOOST_REGEX_BLOCKSIZE);
+      return nullptr;
+   }
+   void* get()
+   {
+      void* p = get_cached();
+      return p ? p : ::operator new(BOOST_REGEX_BLOCKSIZE);
    }
    void put(void* p)
    {
@@ -139,32 +149,184 @@ struct mem_block_cache
 };
 #endif
 
+#ifdef BOOST_REGEX_MEM_BLOCK_STATISTICS
+//
+// Counters behind regex_mem_block_statistics, these are shared by all
+// threads so only kept when asked for:
+//
+struct mem_block_counters
+{
+   std::atomic<std::size_t> thread_hits;
+   std::atomic<std::size_t> global_hits;
+   std::atomic<std::size_t> allocations;
+   std::atomic<std::size_t> in_use;
+
+   static mem_block_counters& instance()
+   {
+      static mem_block_counters counters = { {0}, {0}, {0}, {0} };
+      return counters;
+   }
+};
+#define BOOST_REGEX_COUNT_MEM_BLOCK(name, n) (mem_block_counters::instance().name.fetch_add(n, std::memory_order_relaxed))
+#else
+#define BOOST_REGEX_COUNT_MEM_BLOCK(name, n) ((void)0)
+#endif
+
 #if BOOST_REGEX_MAX_CACHE_BLOCKS == 0
 
-inline void*  get_mem_block()
+inline void*  get_global_mem_block()
 {
+   BOOST_REGEX_COUNT_MEM_BLOCK(allocations, 1);
    return ::operator new(BOOST_REGEX_BLOCKSIZE);
 }
 
-inline void  put_mem_block(void* p)
+inline void  put_global_mem_block(void* p)
 {
    ::operator delete(p);
 }
 
 #else
 
-inline void*  get_mem_block()
+inline void*  get_global_mem_block()
 {
+#ifdef BOOST_REGEX_MEM_BLOCK_STATISTICS
+   void* p = mem_block_cache::instance().get_cached();
+   if(p)
+   {
+      BOOST_REGEX_COUNT_MEM_BLOCK(global_hits, 1);
+      return p;
+   }
+   BOOST_REGEX_COUNT_MEM_BLOCK(allocations, 1);
+   return ::operator new(BOOST_REGEX_BLOCKSIZE);
+#else
    return mem_block_cache::instance().get();
+#endif
 }
 
-inline void  put_mem_block(void* p)
+inline void  put_global_mem_block(void* p)
 {
    mem_block_cache::instance().put(p);
 }
 
 #endif
+
+#if (BOOST_REGEX_MAX_CACHE_BLOCKS > 0) && (BOOST_REGEX_MAX_THREAD_CACHE_BLOCKS > 0) && defined(BOOST_HAS_THREADS) && !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+//
+// A few blocks kept by each thread, in front of the global cache, so that
+// threads which match at the same time don't contend for the same cache
+// lines.  The global cache is only touched when this one is empty or full,
+// and gets back whatever this one holds when the thread exits:
+//
+struct thread_mem_block_cache
+{
+   void* cache[BOOST_REGEX_MAX_THREAD_CACHE_BLOCKS];
+   unsigned count;
+
+   thread_mem_block_cache() : count(0) {}
+   ~thread_mem_block_cache()
+   {
+      while(count)
+         put_global_mem_block(cache[--count]);
+   }
+   void* get()
+   {
+      if(count)
+      {
+         BOOST_REGEX_COUNT_MEM_BLOCK(thread_hits, 1);
+         return cache[--count];
+      }
+      return get_global_mem_block();
+   }
+   void put(void* p)
+   {
+      if(count < BOOST_REGEX_MAX_THREAD_CACHE_BLOCKS)
+         cache[count++] = p;
+      else
+         put_global_mem_block(p);
+   }
+   static thread_mem_block_cache& instance()
+   {
+      static thread_local thread_mem_block_cache block_cache;
+      return block_cache;
+   }
+};
+
+inline void*  get_mem_block()
+{
+   BOOST_REGEX_COUNT_MEM_BLOCK(in_use, 1);
+   return thread_mem_block_cache::instance().get();
+}
+
+inline void  put_mem_block(void* p)
+{
+   BOOST_REGEX_COUNT_MEM_BLOCK(in_use, static_cast<std::size_t>(-1));
+   thread_mem_block_cache::instance().put(p);
+}
+
+#else
+
+inline void*  get_mem_block()
+{
+   BOOST_REGEX_COUNT_MEM_BLOCK(in_use, 1);
+   return get_global_mem_block();
+}
+
+inline void  put_mem_block(void* p)
+{
+   BOOST_REGEX_COUNT_MEM_BLOCK(in_use, static_cast<std::size_t>(-1));
+   put_global_mem_block(p);
+}
+
+#endif
+
+#undef BOOST_REGEX_COUNT_MEM_BLOCK
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
+#ifdef BOOST_REGEX_MEM_BLOCK_STATISTICS
+//
+// How the blocks used for the backtracking stack have been found:
+//
+struct regex_mem_block_statistics
+{
+   std::size_t thread_hits;   // taken from the calling thread's cache
+   std::size_t global_hits;   // taken from the cache shared by all threads
+   std::size_t allocations;   // allocated with ::operator new
+   std::size_t in_use;        // handed out and not yet returned
+
+   double hit_rate()const
+   {
+      std::size_t total = thread_hits + global_hits + allocations;
+      return total ? static_cast<double>(thread_hits + global_hits) / static_cast<double>(total) : 0.0;
+   }
+};
+
+inline regex_mem_block_statistics get_regex_mem_block_statistics()
+{
+   BOOST_REGEX_DETAIL_NS::mem_block_counters& c = BOOST_REGEX_DETAIL_NS::mem_block_counters::instance();
+   regex_mem_block_statistics result = 
+   { 
+      c.thread_hits.load(std::memory_order_relaxed), 
+      c.global_hits.load(std::memory_order_relaxed), 
+      c.allocations.load(std::memory_order_relaxed), 
+      c.in_use.load(std::memory_order_relaxed) 
+   };
+   return result;
 }
+
+//
+// Starts counting hits and allocations again from zero, blocks in use are
+// still blocks in use so that count is left alone:
+//
+inline void reset_regex_mem_block_statistics()
+{
+   BOOST_REGEX_DETAIL_NS::mem_block_counters& c = BOOST_REGEX_DETAIL_NS::mem_block_counters::instance();
+   c.thread_hits.store(0, std::memory_order_relaxed);
+   c.global_hits.store(0, std::memory_order_relaxed);
+   c.allocations.store(0, std::memory_order_relaxed);
+}
+#endif
+
 } // namespace boost
 
 #endif
@@ -20,139 +20,218 @@
 #define BOOST_REGEX_OBJECT_CACHE_HPP
 
 #include <boost/regex/config.hpp>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <map>
-#include <list>
+#include <vector>
 #include <stdexcept>
 #include <string>
 #ifdef BOOST_HAS_THREADS
 #include <mutex>
+#include <thread>
 #endif
 
 namespace boost{
 
+namespace BOOST_REGEX_DETAIL_NS{
+
+/*** class table_readers **********************************************
+Lets readers search a table which writers replace, rather than change,
+without either side taking a lock: a reader enters before loading the
+pointer to the table and leaves once it's done with it, and a writer
+publishes the new table and then calls wait() before freeing the old
+one.  Readers enter one of two slots, picked by the parity of an epoch,
+and wait() moves new readers on to the other slot then waits for each
+slot to empty in turn, after which no reader can still be looking at
+the old table.
+***********************************************************************/
+class table_readers
+{
+public:
+   table_readers() : m_epoch(0)
+   {
+      m_count[0].store(0);
+      m_count[1].store(0);
+   }
+
+   unsigned enter()const
+   {
+      unsigned slot = m_epoch.load() & 1u;
+      m_count[slot].fetch_add(1);
+      return slot;
+   }
+   void leave(unsigned slot)const
+   {
+      m_count[slot].fetch_sub(1);
+   }
+   void wait()
+   {
+      for(unsigned i = 0; i < 2; ++i)
+      {
+         unsigned slot = m_epoch.fetch_add(1) & 1u;
+         while(m_count[slot].load() != 0)
+         {
+#ifdef BOOST_HAS_THREADS
+            std::this_thread::yield();
+#endif
+         }
+      }
+   }
+
+private:
+   table_readers(const table_readers&);
+   table_readers& operator=(const table_readers&);
+
+   std::atomic<unsigned>         m_epoch;
+   mutable std::atomic<unsigned> m_count[2];
+};
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
+//
+// Holds the Objects constructed from recently used Keys: the objects
+// are kept in a table sorted by key which is never changed once
+// published, so that finding an object already in the cache takes no
+// lock.  Misses construct the new object, then lock out other writers
+// while they copy the table, add the object, drop the least recently
+// used objects that nobody else holds, and publish the copy.
+//
 template <class Key, class Object>
 class object_cache
 {
 public:
-   typedef std::pair< ::std::shared_ptr<Object const>, Key const*> value_type;
-   typedef std::list<value_type> list_type;
-   typedef typename list_type::iterator list_iterator;
-   typedef std::map<Key, list_iterator> map_type;
-   typedef typename map_type::iterator map_iterator;
-   typedef typename list_type::size_type size_type;
+   typedef std::size_t size_type;
    static std::shared_ptr<Object const> get(const Key& k, size_type l_max_cache_size);
 
 private:
-   static std::shared_ptr<Object const> do_get(const Key& k, size_type l_max_cache_size);
+   struct entry
+   {
+      entry(const Key& k, std::uint64_t now) : key(k), object(new Object(k)), last_used(now) {}
+
+      Key                                  key;
+      std::shared_ptr<Object const>        object;
+      mutable std::atomic<std::uint64_t>   last_used;  // the clock when last found
+   };
+   typedef std::vector<std::shared_ptr<entry> > table_type;
 
    struct data
    {
-      list_type   cont;
-      map_type    index;
+      data() : table(0), clock(0) {}
+      ~data() { delete table.load(); }
+
+      std::atomic<const table_type*>       table;
+      std::atomic<std::uint64_t>           clock;      // moves on with each miss
+      BOOST_REGEX_DETAIL_NS::table_readers readers;
+#ifdef BOOST_HAS_THREADS
+      std::mutex                           writer;
+#endif
    };
 
+   static data& get_data()
+   {
+      static data s_data;
+      return s_data;
+   }
+   static typename table_type::const_iterator lower_bound(const table_type& table, const Key& k);
+   static std::shared_ptr<Object const> insert(data& d, const std::shared_ptr<entry>& e, size_type l_max_cache_size);
+
    // Needed by compilers not implementing the resolution to DR45. For reference,
    // see http://www.open-std.org/JTC1/SC22/WG21/docs/cwg_defects.html#45.
    friend struct data;
 };
 
-#ifdef BOOST_REGEX_MSVC
-#pragma warning(push)
-#pragma warning(disable: 4702)
-#endif
 template <class Key, class Object>
-std::shared_ptr<Object const> object_cache<Key, Object>::get(const Key& k, size_type l_max_cache_size)
+typename object_cache<Key, Object>::table_type::const_iterator object_cache<Key, Object>::lower_bound(const table_type& table, const Key& k)
 {
-#ifdef BOOST_HAS_THREADS
-   static std::mutex mut;
-   std::lock_guard<std::mutex> l(mut);
-   return do_get(k, l_max_cache_size);
-#else
-   return do_get(k, l_max_cache_size);
-#endif
+   typename table_type::const_iterator first = table.begin();
+   typename table_type::difference_type len = table.end() - first;
+   while(len > 0)
+   {
+      typename table_type::difference_type half = len / 2;
+      if((*(first + half))->key < k)
+      {
+         first += half + 1;
+         len -= half + 1;
+      }
+      else
+         len = half;
+   }
+   return first;
 }
-#ifdef BOOST_REGEX_MSVC
-#pragma warning(pop)
-#endif
 
 template <class Key, class Object>
-std::shared_ptr<Object const> object_cache<Key, Object>::do_get(const Key& k, size_type l_max_cache_size)
+std::shared_ptr<Object const> object_cache<Key, Object>::get(const Key& k, size_type l_max_cache_size)
 {
-   typedef typename object_cache<Key, Object>::data object_data;
-   typedef typename map_type::size_type map_size_type;
-   static object_data s_data;
-
+   data& d = get_data();
+   const std::uint64_t now = d.clock.load(std::memory_order_relaxed);
+   std::shared_ptr<Object const> result;
    //
    // see if the object is already in the cache:
    //
-   map_iterator mpos = s_data.index.find(k);
-   if(mpos != s_data.index.end())
+   unsigned slot = d.readers.enter();
+   const table_type* table = d.table.load();
+   if(table)
    {
-      //
-      // Eureka! 
-      // We have a cached item, bump it up the list and return it:
-      //
-      if(--(s_data.cont.end()) != mpos->second)
+      typename table_type::const_iterator pos = lower_bound(*table, k);
+      if((pos != table->end()) && !(k < (*pos)->key))
       {
-         // splice out the item we want to move:
-         list_type temp;
-         temp.splice(temp.end(), s_data.cont, mpos->second);
-         // and now place it at the end of the list:
-         s_data.cont.splice(s_data.cont.end(), temp, temp.begin());
-         BOOST_REGEX_ASSERT(*(s_data.cont.back().second) == k);
-         // update index with new position:
-         mpos->second = --(s_data.cont.end());
-         BOOST_REGEX_ASSERT(&(mpos->first) == mpos->second->second);
-         BOOST_REGEX_ASSERT(&(mpos->first) == s_data.cont.back().second);
+         // only write to the entry when the clock has moved on, so that
+         // threads using the same object don't fight over it:
+         if((*pos)->last_used.load(std::memory_order_relaxed) != now)
+            (*pos)->last_used.store(now, std::memory_order_relaxed);
+         result = (*pos)->object;
       }
-      return s_data.cont.back().first;
    }
+   d.readers.leave(slot);
+   if(result)
+      return result;
    //
    // if we get here then the item is not in the cache,
-   // so create it:
+   // so create it, outside of any lock:
    //
-   std::shared_ptr<Object const> result(new Object(k));
+   std::shared_ptr<entry> e(new entry(k, d.clock.fetch_add(1, std::memory_order_relaxed) + 1));
+   return insert(d, e, l_max_cache_size);
+}
+
+template <class Key, class Object>
+std::shared_ptr<Object const> object_cache<Key, Object>::insert(data& d, const std::shared_ptr<entry>& e, size_type l_max_cache_size)
+{
+#ifdef BOOST_HAS_THREADS
+   std::lock_guard<std::mutex> l(d.writer);
+#endif
+   const table_type* old = d.table.load();
+   std::unique_ptr<table_type> table(old ? new table_type(*old) : new table_type());
+   typename table_type::const_iterator pos = lower_bound(*table, e->key);
+   if((pos != table->end()) && !(e->key < (*pos)->key))
+   {
+      // another thread got there first:
+      return (*pos)->object;
+   }
+   table->insert(table->begin() + (pos - table->begin()), e);
    //
-   // Add it to the list, and index it:
+   // If we have too many items then drop the least recently used,
+   // but only if they're being held uniquely by us:
    //
-   s_data.cont.push_back(value_type(result, static_cast<Key const*>(0)));
-   s_data.index.insert(std::make_pair(k, --(s_data.cont.end())));
-   s_data.cont.back().second = &(s_data.index.find(k)->first);
-   map_size_type s = s_data.index.size();
-   BOOST_REGEX_ASSERT(s_data.index[k]->first.get() == result.get());
-   BOOST_REGEX_ASSERT(&(s_data.index.find(k)->first) == s_data.cont.back().second);
-   BOOST_REGEX_ASSERT(s_data.index.find(k)->first == k);
-   if(s > l_max_cache_size)
+   while(table->size() > l_max_cache_size)
    {
-      //
-      // We have too many items in the list, so we need to start
-      // popping them off the back of the list, but only if they're
-      // being held uniquely by us:
-      //
-      list_iterator pos = s_data.cont.begin();
-      list_iterator last = s_data.cont.end();
-      while((pos != last) && (s > l_max_cache_size))
+      typename table_type::iterator victim = table->end();
+      for(typename table_type::iterator i = table->begin(); i != table->end(); ++i)
       {
-         if(pos->first.use_count() == 1)
-         {
-            list_iterator condemmed(pos);
-            ++pos;
-            // now remove the items from our containers, 
-            // then order has to be as follows:
-            BOOST_REGEX_ASSERT(s_data.index.find(*(condemmed->second)) != s_data.index.end());
-            s_data.index.erase(*(condemmed->second));
-            s_data.cont.erase(condemmed); 
-            --s;
-         }
-         else
-            ++pos;
+         if((*i != e) && ((*i)->object.use_count() == 1)
+            && ((victim == table->end()) || ((*i)->last_used.load(std::memory_order_relaxed) < (*victim)->last_used.load(std::memory_order_relaxed))))
+            victim = i;
       }
-      BOOST_REGEX_ASSERT(s_data.index[k]->first.get() == result.get());
-      BOOST_REGEX_ASSERT(&(s_data.index.find(k)->first) == s_data.cont.back().second);
-      BOOST_REGEX_ASSERT(s_data.index.find(k)->first == k);
+      if(victim == table->end())
+         break;
+      table->erase(victim);
+   }
+   d.table.store(table.release());
+   if(old)
+   {
+      d.readers.wait();
+      delete old;
    }
-   return result;
+   return e->object;
 }
 
 }
@@ -0,0 +1,306 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         parallel_regex_search.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Provides parallel_regex_search_all, which finds the
+  *                same matches as regex_iterator, but searches a large
+  *                buffer in chunks on several threads at once.
+  *                Note this is an internal header file included
+  *                by regex.hpp, do not include on its own.
+  */
+
+#ifndef BOOST_REGEX_V5_PARALLEL_REGEX_SEARCH_HPP
+#define BOOST_REGEX_V5_PARALLEL_REGEX_SEARCH_HPP
+
+#ifdef BOOST_HAS_THREADS
+#include <thread>
+#endif
+
+namespace boost{
+
+namespace BOOST_REGEX_DETAIL_NS{
+
+//
+// The smallest chunk worth handing to a thread of its own:
+//
+static const std::ptrdiff_t parallel_search_min_chunk = 4096;
+
+//
+// Whether an expression can find different matches depending on where
+// the search starts, other than by skipping over matches that start
+// earlier - if so the input can't be split up:
+//
+template <class charT, class traits>
+bool depends_on_search_start(const basic_regex<charT, traits>& e)
+{
+   for(const re_syntax_base* state = e.get_first_state(); state; state = state->next.p)
+   {
+      switch(state->type)
+      {
+      case syntax_element_restart_continue:  // \G
+      case syntax_element_commit:            // (*COMMIT), (*PRUNE) and (*SKIP)
+         return true;
+      case syntax_element_startmark:
+         if(static_cast<const re_brace*>(state)->index == -5)  // \K
+            return true;
+         break;
+      default:
+         break;
+      }
+   }
+   return false;
+}
+
+//
+// Where regex_iterator starts its next search from, and whether that
+// search may find a null match at its start:
+//
+template <class BidiIterator>
+struct parallel_search_state
+{
+   BidiIterator position;
+   bool not_initial_null;
+
+   bool operator==(const parallel_search_state& that)const
+   {
+      return (position == that.position) && (not_initial_null == that.not_initial_null);
+   }
+};
+
+/*** struct parallel_search_chunk *************************************
+The matches in one chunk of the input, found by following the same
+steps as regex_iterator would, but starting from the start of the
+chunk: states[i] is the state that matches[i] was searched for from,
+and states.back() the state after the last match.  A chunk's matches
+have to start before its end, except in the last chunk.  Chunks which
+haven't been searched, or whose search threw, aren't complete.
+***********************************************************************/
+template <class BidiIterator>
+struct parallel_search_chunk
+{
+   BidiIterator start;
+   BidiIterator end;
+   std::vector<parallel_search_state<BidiIterator> > states;
+   std::vector<match_results<BidiIterator> > matches;
+   bool complete;
+};
+
+//
+// One step of regex_iterator, but giving up on matches which start at
+// or after limit:
+//
+template <class BidiIterator, class charT, class traits>
+bool parallel_search_step(BidiIterator first, BidiIterator last, BidiIterator limit,
+                          const basic_regex<charT, traits>& e, match_flag_type flags,
+                          parallel_search_state<BidiIterator>& state,
+                          match_results<BidiIterator>& what)
+{
+   typedef typename match_results<BidiIterator>::allocator_type match_alloc_type;
+   if(state.not_initial_null)
+      flags |= regex_constants::match_not_initial_null;
+   perl_matcher<BidiIterator, match_alloc_type, traits> matcher(state.position, last, what, e, flags, first);
+   matcher.set_search_limit(limit);
+   if(!matcher.find() || ((limit != last) && !(what[0].first < limit)))
+      return false;
+   what.set_base(first);
+   state.position = what[0].second;
+   state.not_initial_null = (what.length() == 0) || (flags & regex_constants::match_posix);
+   return true;
+}
+
+template <class BidiIterator, class charT, class traits>
+void parallel_search_worker(BidiIterator first, BidiIterator last,
+                            const basic_regex<charT, traits>* e, match_flag_type flags,
+                            parallel_search_chunk<BidiIterator>* chunk)
+{
+#ifndef BOOST_NO_EXCEPTIONS
+   try{
+#endif
+   parallel_search_state<BidiIterator> state = { chunk->start, false };
+   match_results<BidiIterator> what;
+   chunk->states.push_back(state);
+   while(parallel_search_step(first, last, chunk->end, *e, flags, state, what))
+   {
+      chunk->matches.push_back(match_results<BidiIterator>());
+      chunk->matches.back().swap(what);
+      chunk->states.push_back(state);
+      if((chunk->end != last) && !(state.position < chunk->end))
+         break;
+   }
+   chunk->complete = true;
+#ifndef BOOST_NO_EXCEPTIONS
+   }
+   catch(...)
+   {
+      // leave this chunk to be searched again in order, which will only
+      // throw if regex_iterator would have:
+   }
+#endif
+}
+
+//
+// Splits [first, last) into up to count chunks, ending each just after
+// a line break when there's one nearby, since few matches span lines:
+//
+template <class BidiIterator, class charT>
+void parallel_search_split(BidiIterator first, BidiIterator last, std::size_t count,
+                           std::vector<parallel_search_chunk<BidiIterator> >& chunks, charT)
+{
+   std::ptrdiff_t len = last - first;
+   if(static_cast<std::ptrdiff_t>(count) > len / parallel_search_min_chunk)
+      count = static_cast<std::size_t>(len / parallel_search_min_chunk);
+   if(count < 1)
+      count = 1;
+   std::ptrdiff_t step = len / static_cast<std::ptrdiff_t>(count);
+   BidiIterator start = first;
+   for(std::size_t i = 1; i < count; ++i)
+   {
+      BidiIterator cut = first + step * static_cast<std::ptrdiff_t>(i);
+      BidiIterator stop = cut + step / 2;
+      BidiIterator p = cut;
+      while((p != stop) && (*p != static_cast<charT>('\n')))
+         ++p;
+      if(p != stop)
+         cut = ++p;
+      if(!(start < cut) || !(cut < last))
+         continue;
+      chunks.push_back(parallel_search_chunk<BidiIterator>());
+      chunks.back().start = start;
+      chunks.back().end = cut;
+      chunks.back().complete = false;
+      start = cut;
+   }
+   chunks.push_back(parallel_search_chunk<BidiIterator>());
+   chunks.back().start = start;
+   chunks.back().end = last;
+   chunks.back().complete = false;
+}
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
+//
+// Finds the same matches, in the same order, as iterating a
+// regex_iterator over [first, last) with the same flags would, using up
+// to max_threads threads (or one per core when zero).  Each thread
+// searches its own chunk of the input, reading past the end of it as
+// far as any match starting inside it needs to, and the results are
+// then stitched together, re-searching only where the match before a
+// chunk boundary ends somewhere that the search of the next chunk
+// didn't pass through.
+//
+template <class BidiIterator, class charT, class traits>
+std::vector<match_results<BidiIterator> >
+   parallel_regex_search_all(BidiIterator first, BidiIterator last,
+                             const basic_regex<charT, traits>& e,
+                             match_flag_type flags = match_default,
+                             std::size_t max_threads = 0)
+{
+   typedef typename std::iterator_traits<BidiIterator>::iterator_category category;
+   static_assert(std::is_convertible<category, std::random_access_iterator_tag>::value, "parallel_regex_search_all requires random access iterators");
+   typedef BOOST_REGEX_DETAIL_NS::parallel_search_chunk<BidiIterator> chunk_type;
+   typedef BOOST_REGEX_DETAIL_NS::parallel_search_state<BidiIterator> state_type;
+
+   std::vector<match_results<BidiIterator> > result;
+   if(e.flags() & regex_constants::failbit)
+      return result;
+
+   // anything which stops each search being independent of the last has to be done in order:
+   std::size_t count = max_threads;
+#ifdef BOOST_HAS_THREADS
+   if(count == 0)
+      count = std::thread::hardware_concurrency();
+#else
+   count = 1;
+#endif
+   if((flags & (regex_constants::match_continuous | regex_constants::match_partial))
+      || BOOST_REGEX_DETAIL_NS::depends_on_search_start(e))
+      count = 1;
+
+   std::vector<chunk_type> chunks;
+   BOOST_REGEX_DETAIL_NS::parallel_search_split(first, last, count, chunks, charT());
+#ifdef BOOST_HAS_THREADS
+   // with only one chunk there's nothing to search ahead, the walk below does it all:
+   if(chunks.size() > 1)
+   {
+      std::vector<std::thread> threads;
+      for(std::size_t i = 1; i < chunks.size(); ++i)
+         threads.push_back(std::thread(&BOOST_REGEX_DETAIL_NS::parallel_search_worker<BidiIterator, charT, traits>, first, last, &e, flags, &chunks[i]));
+      BOOST_REGEX_DETAIL_NS::parallel_search_worker(first, last, &e, flags, &chunks[0]);
+      for(std::size_t i = 0; i < threads.size(); ++i)
+         threads[i].join();
+   }
+#endif
+
+   //
+   // Now walk through the chunks in order, following regex_iterator:
+   // on entering each chunk, the next match starts in it or later.
+   //
+   state_type state = { first, false };
+   match_results<BidiIterator> what;
+   for(std::size_t i = 0; i < chunks.size(); ++i)
+   {
+      chunk_type& chunk = chunks[i];
+      std::size_t j = 0;
+      while((chunk.end == last) || (state.position < chunk.end))
+      {
+         if(chunk.complete)
+         {
+            // If we're before the chunk then the next match is the first in it,
+            // otherwise see if the chunk's search went through the same state:
+            bool before = state.position < chunk.start;
+            if(!before)
+            {
+               while((j < chunk.states.size()) && (chunk.states[j].position < state.position))
+                  ++j;
+               while((j < chunk.states.size()) && (chunk.states[j].position == state.position) && !(chunk.states[j] == state))
+                  ++j;
+            }
+            if(before || ((j < chunk.states.size()) && (chunk.states[j] == state)))
+            {
+               if(before)
+                  j = 0;
+               if(j < chunk.matches.size())
+               {
+                  std::size_t first_new = result.size();
+                  result.resize(first_new + chunk.matches.size() - j);
+                  for(std::size_t k = j; k < chunk.matches.size(); ++k)
+                     result[first_new + k - j].swap(chunk.matches[k]);
+                  // $` runs from where regex_iterator's search would have started:
+                  result[first_new].set_prefix_first(state.position);
+                  state = chunk.states.back();
+               }
+               break;
+            }
+         }
+         if(!BOOST_REGEX_DETAIL_NS::parallel_search_step(first, last, chunk.end, e, flags, state, what))
+            break;
+         result.push_back(match_results<BidiIterator>());
+         result.back().swap(what);
+      }
+   }
+   return result;
+}
+
+template <class ST, class SA, class charT, class traits>
+inline std::vector<match_results<typename std::basic_string<charT, ST, SA>::const_iterator> >
+   parallel_regex_search_all(const std::basic_string<charT, ST, SA>& s,
+                             const basic_regex<charT, traits>& e,
+                             match_flag_type flags = match_default,
+                             std::size_t max_threads = 0)
+{
+   return parallel_regex_search_all(s.begin(), s.end(), e, flags, max_threads);
+}
+
+} // namespace boost
+
+#endif  // BOOST_REGEX_V5_PARALLEL_REGEX_SEARCH_HPP
@@ -29,6 +29,12 @@
 #endif
 
 namespace boost{
+//
+// Forward declaration:
+//
+template <class BidiIterator, class Allocator = typename std::vector<sub_match<BidiIterator> >::allocator_type >
+class regex_match_context;
+
 namespace BOOST_REGEX_DETAIL_NS{
 
 //
@@ -85,6 +91,184 @@ inline bool can_start(unsigned int c, const unsigned char* map, unsigned char ma
    return (((c >= static_cast<unsigned int>(1u << CHAR_BIT)) ? true : map[c] & mask));
 }
 #endif
+template <class charT>
+inline bool can_start(charT c, const re_bitmap& map)
+{
+   return ((c < static_cast<charT>(0)) ? true : ((c >= static_cast<charT>(1 << CHAR_BIT)) ? true : map.test(static_cast<unsigned char>(c))));
+}
+inline bool can_start(char c, const re_bitmap& map)
+{
+   return map.test(static_cast<unsigned char>(c));
+}
+inline bool can_start(signed char c, const re_bitmap& map)
+{
+   return map.test(static_cast<unsigned char>(c));
+}
+inline bool can_start(unsigned char c, const re_bitmap& map)
+{
+   return map.test(c);
+}
+inline bool can_start(unsigned short c, const re_bitmap& map)
+{
+   return ((c >= (1 << CHAR_BIT)) ? true : map.test(static_cast<unsigned char>(c)));
+}
+#if defined(WCHAR_MIN) && (WCHAR_MIN == 0) && !defined(BOOST_NO_INTRINSIC_WCHAR_T)
+inline bool can_start(wchar_t c, const re_bitmap& map)
+{
+   return ((c >= static_cast<wchar_t>(1u << CHAR_BIT)) ? true : map.test(static_cast<unsigned char>(c)));
+}
+#endif
+#if !defined(BOOST_NO_INTRINSIC_WCHAR_T)
+inline bool can_start(unsigned int c, const re_bitmap& map)
+{
+   return (((c >= static_cast<unsigned int>(1u << CHAR_BIT)) ? true : map.test(static_cast<unsigned char>(c))));
+}
+#endif
+//
+// function find_start:
+// skips to the next character that can start a match, narrow characters
+// held in contiguous memory can be searched a block at a time:
+//
+template <class iterator>
+inline iterator find_start(iterator first, iterator last, const unsigned char* map, const startmap_search&, std::integral_constant<bool, false>*)
+{
+   while((first != last) && !can_start(*first, map, (unsigned char)mask_any))
+      ++first;
+   return first;
+}
+template <class iterator>
+inline iterator find_start(iterator first, iterator last, const unsigned char* map, const startmap_search& s, std::integral_constant<bool, true>*)
+{
+   if(first == last)
+      return first;
+   const unsigned char* base = reinterpret_cast<const unsigned char*>(array_pointer(first));
+   return first + (s.find(base, base + (last - first), map) - base);
+}
+template <class iterator>
+inline iterator find_start(iterator first, iterator last, const unsigned char* map, const startmap_search& s)
+{
+   return find_start(first, last, map, s, static_cast<std::integral_constant<bool, is_byte_array<iterator>::value>*>(0));
+}
+
+//
+// functions skip_char, skip_set and skip_wild:
+// return the end of the run of characters from first matched by a
+// single character repeat of a literal, a set or a wildcard that
+// doesn't match line separators and/or nul.  Narrow characters held in contiguous
+// memory are checked a block at a time where the state allows it:
+//
+template <class iterator, class charT, class traits>
+inline iterator skip_char(iterator first, iterator last, charT what, const traits& t, bool icase, bool, std::integral_constant<bool, false>*)
+{
+   while((first != last) && (t.translate(*first, icase) == what))
+      ++first;
+   return first;
+}
+template <class iterator, class charT, class traits>
+inline iterator skip_char(iterator first, iterator last, charT what, const traits& t, bool icase, bool raw, std::integral_constant<bool, true>*)
+{
+   if(!raw || icase || (first == last))
+      return skip_char(first, last, what, t, icase, raw, static_cast<std::integral_constant<bool, false>*>(0));
+   const unsigned char* base = reinterpret_cast<const unsigned char*>(array_pointer(first));
+   return first + (find_not_char(base, base + (last - first), static_cast<unsigned char>(what)) - base);
+}
+template <class iterator, class charT, class traits>
+inline iterator skip_char(iterator first, iterator last, charT what, const traits& t, bool icase, bool raw)
+{
+   return skip_char(first, last, what, t, icase, raw, static_cast<std::integral_constant<bool, is_byte_array<iterator>::value>*>(0));
+}
+
+template <class iterator, class traits>
+inline iterator skip_set(iterator first, iterator last, const re_set* set, const traits& t, bool icase, std::integral_constant<bool, false>*)
+{
+   while((first != last) && set->_map.test(static_cast<unsigned char>(t.translate(*first, icase))))
+      ++first;
+   return first;
+}
+template <class iterator, class traits>
+inline iterator skip_set(iterator first, iterator last, const re_set* set, const traits& t, bool icase, std::integral_constant<bool, true>*)
+{
+   if(!set->_span.usable(icase) || (first == last))
+      return skip_set(first, last, set, t, icase, static_cast<std::integral_constant<bool, false>*>(0));
+   const unsigned char* base = reinterpret_cast<const unsigned char*>(array_pointer(first));
+   return first + (set->_span.find_not(base, base + (last - first)) - base);
+}
+template <class iterator, class traits>
+inline iterator skip_set(iterator first, iterator last, const re_set* set, const traits& t, bool icase)
+{
+   return skip_set(first, last, set, t, icase, static_cast<std::integral_constant<bool, is_byte_array<iterator>::value>*>(0));
+}
+
+template <class iterator>
+inline iterator skip_wild(iterator first, iterator last, bool not_separator, bool not_null, std::integral_constant<bool, false>*)
+{
+   typedef typename std::iterator_traits<iterator>::value_type char_type;
+   while((first != last) && !(not_separator && is_separator(*first)) && !(not_null && (*first == char_type(0))))
+      ++first;
+   return first;
+}
+template <class iterator>
+inline iterator skip_wild(iterator first, iterator last, bool not_separator, bool not_null, std::integral_constant<bool, true>*)
+{
+   if(first == last)
+      return first;
+   const unsigned char* base = reinterpret_cast<const unsigned char*>(array_pointer(first));
+   return first + (find_separator(base, base + (last - first), not_separator, not_null) - base);
+}
+template <class iterator>
+inline iterator skip_wild(iterator first, iterator last, bool not_separator, bool not_null)
+{
+   return skip_wild(first, last, not_separator, not_null, static_cast<std::integral_constant<bool, is_byte_array<iterator>::value>*>(0));
+}
+
+//
+// function rfind_literal:
+// returns the last position in [first, last) at which the len characters
+// in what match without running past end, or last if there isn't one.
+// Used to back up a greedy repeat straight to the literal which follows it:
+//
+template <class iterator, class charT, class traits>
+iterator rfind_literal(iterator first, iterator last, iterator end, const charT* what, std::size_t len, const traits& t, bool icase, bool, std::integral_constant<bool, false>*)
+{
+   iterator pos = last;
+   while(pos != first)
+   {
+      --pos;
+      if(t.translate(*pos, icase) != what[0])
+         continue;
+      iterator next = pos;
+      std::size_t i = 1;
+      while((i < len) && (++next != end) && (t.translate(*next, icase) == what[i]))
+         ++i;
+      if(i == len)
+         return pos;
+   }
+   return last;
+}
+template <class iterator, class charT, class traits>
+iterator rfind_literal(iterator first, iterator last, iterator end, const charT* what, std::size_t len, const traits& t, bool icase, bool raw, std::integral_constant<bool, true>*)
+{
+   if(!raw || icase || (first == last))
+      return rfind_literal(first, last, end, what, len, t, icase, raw, static_cast<std::integral_constant<bool, false>*>(0));
+   const unsigned char* base = reinterpret_cast<const unsigned char*>(array_pointer(first));
+   const unsigned char* pos = base + (last - first);
+   const unsigned char* stop = base + (end - first);
+   while(pos != base)
+   {
+      const unsigned char* found = rfind_char(base, pos, static_cast<unsigned char>(what[0]));
+      if(found == pos)
+         break;
+      if((static_cast<std::size_t>(stop - found) >= len) && (std::memcmp(found + 1, what + 1, len - 1) == 0))
+         return first + (found - base);
+      pos = found;
+   }
+   return last;
+}
+template <class iterator, class charT, class traits>
+inline iterator rfind_literal(iterator first, iterator last, iterator end, const charT* what, std::size_t len, const traits& t, bool icase, bool raw)
+{
+   return rfind_literal(first, last, end, what, len, t, icase, raw, static_cast<std::integral_constant<bool, is_byte_array<iterator>::value>*>(0));
+}
 
 template <class C, class T, class A>
 inline int string_compare(const std::basic_string<C,T,A>& s, const C* p)
@@ -353,18 +537,31 @@ public:
    typedef typename is_byte<char_type>::width_type width_type;
    typedef typename std::iterator_traits<BidiIterator>::difference_type difference_type;
    typedef match_results<BidiIterator, Allocator> results_type;
+   typedef regex_match_context<BidiIterator, Allocator> context_type;
 
    perl_matcher(BidiIterator first, BidiIterator end, 
       match_results<BidiIterator, Allocator>& what, 
       const basic_regex<char_type, traits>& e,
       match_flag_type f,
-      BidiIterator l_base)
-      :  m_result(what), base(first), last(end), 
+      BidiIterator l_base,
+      context_type* context = 0)
+      :  m_result(what), m_context(context), base(first), last(end), 
          position(first), backstop(l_base), re(e), traits_inst(e.get_traits()), 
          m_independent(false), next_count(&rep_obj), rep_obj(&next_count)
       , m_recursions(0)
    {
       construct_init(e, f);
+      // borrow the storage left behind by the last user of the context:
+      if(m_context)
+         recursion_stack.swap(m_context->get_recursion_stack());
+   }
+   ~perl_matcher()
+   {
+      if(m_context)
+      {
+         recursion_stack.clear();
+         recursion_stack.swap(m_context->get_recursion_stack());
+      }
    }
 
    bool match();
@@ -374,6 +571,7 @@ public:
    { m_match_flags |= f; }
    void unsetf(match_flag_type f)
    { m_match_flags &= ~f; }
+   void set_search_limit(BidiIterator limit);
 
 private:
    void construct_init(const basic_regex<char_type, traits>& e, match_flag_type f);
@@ -433,10 +631,23 @@ private:
    bool find_restart_line();
    bool find_restart_buf();
    bool find_restart_lit();
+   // required literal prefilter:
+   bool find_required_literal();
+   bool skip_to_required_literal(std::random_access_iterator_tag*);
+   bool skip_to_required_literal(void*);
+   // lazy DFA, used with match_dfa:
+   int find_with_dfa(_narrow_type*);
+   int find_with_dfa(_wide_type*);
+   int match_with_dfa(_narrow_type*);
+   int match_with_dfa(_wide_type*);
+   int find_with_pike_vm(_narrow_type*, bool anchored, bool resumed);
+   int find_with_pike_vm(_wide_type*, bool anchored, bool resumed);
 
 private:
    // final result structure to be filled in:
    match_results<BidiIterator, Allocator>& m_result;
+   // storage to reuse in place of our own, if any:
+   context_type* m_context;
    // temporary result for POSIX matches:
    std::unique_ptr<match_results<BidiIterator, Allocator> > m_temp_match;
    // pointer to actual result structure to fill in:
@@ -453,6 +664,12 @@ private:
    BidiIterator search_base;
    // how far we can go back when matching lookbehind:
    BidiIterator backstop;
+   // next occurrence of the literal that every match must contain:
+   BidiIterator m_required_position;
+   // find() may stop looking for a match once it reaches this position:
+   BidiIterator m_search_limit;
+   // and for the required literal once it reaches this one:
+   BidiIterator m_required_limit;
    // the expression being examined:
    const basic_regex<char_type, traits>& re;
    // the expression's traits class:
@@ -67,7 +67,9 @@ void perl_matcher<BidiIterator, Allocator, traits>::construct_init(const basic_r
       else
          m_match_flags |= match_posix;
    }
-   if(m_match_flags & match_posix)
+   if((m_match_flags & match_posix) && m_context)
+      m_presult = &m_context->get_temp_match();
+   else if(m_match_flags & match_posix)
    {
       m_temp_match.reset(new match_results<BidiIterator, Allocator>());
       m_presult = m_temp_match.get();
@@ -76,6 +78,8 @@ void perl_matcher<BidiIterator, Allocator, traits>::construct_init(const basic_r
       m_presult = &m_result;
    m_stack_base = 0;
    m_backup_state = 0;
+   m_search_limit = last;
+   m_required_limit = last;
    // find the value to use for matching word boundaries:
    m_word_mask = re.get_data().m_word_mask; 
    // find bitmask to use for matching '.':
@@ -88,6 +92,27 @@ void perl_matcher<BidiIterator, Allocator, traits>::construct_init(const basic_r
 #  pragma warning(pop)
 #endif
 
+template <class BidiIterator, class Allocator, class traits>
+void perl_matcher<BidiIterator, Allocator, traits>::set_search_limit(BidiIterator limit)
+{
+   //
+   // Lets find() give up on matches which start at or after limit, without
+   // looking through the rest of the input for one.  Note that this is only
+   // a hint: a match which starts further on may still be found, so callers
+   // have to check where it starts.
+   //
+   m_search_limit = limit;
+   // a match starting before limit has its required literal no further in than:
+   const regex_data<char_type, traits>& data = re.get_data();
+   if(!data.m_required.empty() && (data.m_required_offset != (std::numeric_limits<std::size_t>::max)()))
+   {
+      std::size_t reach = data.m_required_offset + data.m_required.size();
+      m_required_limit = limit;
+      while((m_required_limit != last) && reach--)
+         ++m_required_limit;
+   }
+}
+
 template <class BidiIterator, class Allocator, class traits>
 void perl_matcher<BidiIterator, Allocator, traits>::estimate_max_state_count(std::random_access_iterator_tag*)
 {
@@ -176,7 +201,7 @@ template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::match_imp()
 {
    // initialise our stack if we are non-recursive:
-   save_state_init init(&m_stack_base, &m_backup_state);
+   save_state_init init(&m_stack_base, &m_backup_state, m_context ? &m_context->get_stack_block() : 0);
    used_block_count = BOOST_REGEX_MAX_BLOCKS;
 #if !defined(BOOST_NO_EXCEPTIONS)
    try{
@@ -189,16 +214,44 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_imp()
    m_match_flags |= regex_constants::match_all;
    m_presult->set_size((m_match_flags & match_nosubs) ? 1u : static_cast<typename results_type::size_type>(1u + re.mark_count()), search_base, last);
    m_presult->set_base(base);
-   m_presult->set_named_subs(this->re.get_named_subs());
+   if(!m_presult->has_named_subs(&re.get_data()))
+      m_presult->set_named_subs(this->re.get_named_subs());
    if(m_match_flags & match_posix)
       m_result = *m_presult;
    verify_options(re.flags(), m_match_flags);
+   if(!find_required_literal())
+      return false;
+   // let the DFA tell us if there's no match without any backtracking:
+   if((m_match_flags & match_dfa) && (match_with_dfa(static_cast<width_type*>(0)) == dfa_no_match))
+      return false;
+   if(m_match_flags & match_linear)
+   {
+      int r = find_with_pike_vm(static_cast<width_type*>(0), true, false);
+      if(r != dfa_failed)
+         return r == dfa_matched;
+   }
    if(0 == match_prefix())
       return false;
    return (m_result[0].second == last) && (m_result[0].first == base);
 
 #if !defined(BOOST_NO_EXCEPTIONS)
    }
+#ifdef BOOST_REGEX_LINEAR_FALLBACK
+   catch(const std::runtime_error&)
+   {
+      // too complex to backtrack through, try again with the Pike VM if we can:
+      bool too_complex = (state_count > max_state_count) || (used_block_count == 0);
+      while(unwind(true)){}
+      if(too_complex)
+      {
+         position = base;
+         int r = find_with_pike_vm(static_cast<width_type*>(0), true, false);
+         if(r != dfa_failed)
+            return r == dfa_matched;
+      }
+      throw;
+   }
+#endif
    catch(...)
    {
       // unwind all pushed states, apart from anything else this
@@ -231,8 +284,9 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
    };
 
    // initialise our stack if we are non-recursive:
-   save_state_init init(&m_stack_base, &m_backup_state);
+   save_state_init init(&m_stack_base, &m_backup_state, m_context ? &m_context->get_stack_block() : 0);
    used_block_count = BOOST_REGEX_MAX_BLOCKS;
+   BidiIterator search_start(base);
 #if !defined(BOOST_NO_EXCEPTIONS)
    try{
 #endif
@@ -245,7 +299,8 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
       pstate = re.get_first_state();
       m_presult->set_size((m_match_flags & match_nosubs) ? 1u : static_cast<typename results_type::size_type>(1u + re.mark_count()), base, last);
       m_presult->set_base(base);
-      m_presult->set_named_subs(this->re.get_named_subs());
+      if(!m_presult->has_named_subs(&re.get_data()))
+         m_presult->set_named_subs(this->re.get_named_subs());
       m_match_flags |= regex_constants::match_init;
    }
    else
@@ -273,10 +328,42 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
    }
 
    verify_options(re.flags(), m_match_flags);
+   search_start = position;
+   // give up now if something every match needs isn't there:
+   if(!find_required_literal())
+      return false;
    // find out what kind of expression we have:
    unsigned type = (m_match_flags & match_continuous) ? 
       static_cast<unsigned int>(regbase::restart_continue) 
          : static_cast<unsigned int>(re.get_restart_type());
+   // let the DFA find where the first match starts, then we only need to fill in the details
+   // (it doesn't know where to stop, so isn't used when there's a search limit):
+   if((m_match_flags & match_dfa) && (m_search_limit == last))
+   {
+      int r = find_with_dfa(static_cast<width_type*>(0));
+      if(r == dfa_no_match)
+         return false;
+      if(r == dfa_matched)
+      {
+         if(m_match_flags & match_linear)
+         {
+            // nothing starts before the match the DFA found, but perl_matcher might not
+            // start there, so carry on searching from there as it would:
+            r = find_with_pike_vm(static_cast<width_type*>(0), (m_match_flags & match_continuous) != 0, position != search_start);
+            if(r != dfa_failed)
+               return r == dfa_matched;
+         }
+         if(match_prefix())
+            return true;
+      }
+   }
+   // or find the whole match, sub-expressions and all, without backtracking:
+   if(m_match_flags & match_linear)
+   {
+      int r = find_with_pike_vm(static_cast<width_type*>(0), (m_match_flags & match_continuous) != 0, false);
+      if(r != dfa_failed)
+         return r == dfa_matched;
+   }
 
    // call the appropriate search routine:
    matcher_proc_type proc = s_find_vtable[type];
@@ -284,6 +371,22 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
 
 #if !defined(BOOST_NO_EXCEPTIONS)
    }
+#ifdef BOOST_REGEX_LINEAR_FALLBACK
+   catch(const std::runtime_error&)
+   {
+      // too complex to backtrack through, try again with the Pike VM if we can:
+      bool too_complex = (state_count > max_state_count) || (used_block_count == 0);
+      while(unwind(true)){}
+      if(too_complex)
+      {
+         position = search_start;
+         int r = find_with_pike_vm(static_cast<width_type*>(0), (m_match_flags & match_continuous) != 0, false);
+         if(r != dfa_failed)
+            return r == dfa_matched;
+      }
+      throw;
+   }
+#endif
    catch(...)
    {
       // unwind all pushed states, apart from anything else this
@@ -623,7 +726,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set()
 {
    if(position == last)
       return false;
-   if(static_cast<const re_set*>(pstate)->_map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+   if(static_cast<const re_set*>(pstate)->_map.test(static_cast<unsigned char>(traits_inst.translate(*position, icase))))
    {
       pstate = pstate->next.p;
       ++position;
@@ -794,19 +897,26 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_restart_any()
 #pragma warning(push)
 #pragma warning(disable:4127)
 #endif
+   typedef typename std::iterator_traits<BidiIterator>::iterator_category category;
    const unsigned char* _map = re.get_map();
+   const startmap_search& s = re.get_data().m_startmap_search;
    while(true)
    {
       // skip everything we can't match:
-      while((position != last) && !can_start(*position, _map, (unsigned char)mask_any) )
-         ++position;
-      if(position == last)
+      position = find_start(position, m_search_limit, _map, s);
+      if(position == m_search_limit)
       {
          // run out of characters, try a null match if possible:
          if(re.can_be_null())
             return match_prefix();
          break;
       }
+      // skip anything too far ahead of the required literal:
+      BidiIterator start = position;
+      if(!skip_to_required_literal(static_cast<category*>(0)))
+         return false;
+      if(start != position)
+         continue;
       // now try and obtain a match:
       if(match_prefix())
          return true;
@@ -835,11 +945,11 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_restart_word()
       return true;
    do
    {
-      while((position != last) && traits_inst.isctype(*position, m_word_mask))
+      while((position != m_search_limit) && traits_inst.isctype(*position, m_word_mask))
          ++position;
-      while((position != last) && !traits_inst.isctype(*position, m_word_mask))
+      while((position != m_search_limit) && !traits_inst.isctype(*position, m_word_mask))
          ++position;
-      if(position == last)
+      if(position == m_search_limit)
          break;
 
       if(can_start(*position, _map, (unsigned char)mask_any) )
@@ -863,11 +973,11 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_restart_line()
    const unsigned char* _map = re.get_map();
    if(match_prefix())
       return true;
-   while(position != last)
+   while(position != m_search_limit)
    {
-      while((position != last) && !is_separator(*position))
+      while((position != m_search_limit) && !is_separator(*position))
          ++position;
-      if(position == last)
+      if(position == m_search_limit)
          return false;
       ++position;
       if(position == last)
@@ -900,7 +1010,205 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_restart_buf()
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::find_restart_lit()
 {
+#ifdef BOOST_REGEX_MSVC
+#pragma warning(push)
+#pragma warning(disable:4127)
+#endif
+   //
+   // A partial match may begin with just part of the literal prefix,
+   // so fall back to the general case:
+   //
+   if(m_match_flags & match_partial)
+      return find_restart_any();
+   const literal_search<char_type>& prefix = re.get_data().m_prefix;
+   while(true)
+   {
+      // skip to the next occurrence of the prefix:
+      position = prefix.find(position, m_search_limit, traits_inst);
+      if(position == m_search_limit)
+         return false;
+      // now try and obtain a match:
+      if(match_prefix())
+         return true;
+      if(position == last)
+         return false;
+      ++position;
+   }
    return false;
+#ifdef BOOST_REGEX_MSVC
+#pragma warning(pop)
+#endif
+}
+
+template <class BidiIterator, class Allocator, class traits>
+bool perl_matcher<BidiIterator, Allocator, traits>::find_required_literal()
+{
+   //
+   // If there's a literal that every match has to contain, then there's no
+   // point in searching unless it occurs somewhere after the start position.
+   // Partial matches may stop short of the literal, so don't check for those:
+   //
+   const literal_search<char_type>& required = re.get_data().m_required;
+   m_required_position = last;
+   if(required.empty() || (m_match_flags & match_partial))
+      return true;
+   m_required_position = required.find(position, m_required_limit, traits_inst);
+   return m_required_position != m_required_limit;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+bool perl_matcher<BidiIterator, Allocator, traits>::skip_to_required_literal(std::random_access_iterator_tag*)
+{
+   //
+   // A match starting at position has to contain the required literal no
+   // more than m_required_offset characters in, so move position up
+   // until the next occurrence is in range:
+   //
+   const regex_data<char_type, traits>& data = re.get_data();
+   if(data.m_required.empty() || (m_match_flags & match_partial))
+      return true;
+   if(m_required_position < position)
+   {
+      m_required_position = data.m_required.find(position, m_required_limit, traits_inst);
+      if(m_required_position == m_required_limit)
+         return false;
+   }
+   if((data.m_required_offset != (std::numeric_limits<std::size_t>::max)())
+      && (static_cast<std::size_t>(m_required_position - position) > data.m_required_offset))
+   {
+      position = m_required_position - static_cast<difference_type>(data.m_required_offset);
+      // every match from here on starts beyond the search limit:
+      if(position > m_search_limit)
+         return false;
+   }
+   return true;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+inline bool perl_matcher<BidiIterator, Allocator, traits>::skip_to_required_literal(void*)
+{
+   return true;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+int perl_matcher<BidiIterator, Allocator, traits>::find_with_dfa(_narrow_type*)
+{
+   //
+   // Move position up to the start of the first match, if the DFA can
+   // find it.  The DFA has no notion of these flags, so leave them to
+   // the usual search:
+   //
+   if(m_match_flags & (match_not_null | regex_constants::match_not_initial_null | match_partial | match_all))
+      return dfa_failed;
+   lazy_dfa_lease<char_type, traits> dfa(re.get_data());
+   if(dfa.get() == 0)
+      return dfa_failed;
+   BidiIterator start(position);
+   int r = dfa.get()->find(backstop, position, last, m_match_flags, start);
+   if(r == dfa_matched)
+      position = start;
+   return r;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+inline int perl_matcher<BidiIterator, Allocator, traits>::find_with_dfa(_wide_type*)
+{
+   return dfa_failed;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+int perl_matcher<BidiIterator, Allocator, traits>::match_with_dfa(_narrow_type*)
+{
+   if(m_match_flags & (match_not_null | regex_constants::match_not_initial_null | match_partial))
+      return dfa_failed;
+   lazy_dfa_lease<char_type, traits> dfa(re.get_data());
+   if(dfa.get() == 0)
+      return dfa_failed;
+   return dfa.get()->match(backstop, position, last, m_match_flags);
+}
+
+template <class BidiIterator, class Allocator, class traits>
+inline int perl_matcher<BidiIterator, Allocator, traits>::match_with_dfa(_wide_type*)
+{
+   return dfa_failed;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+int perl_matcher<BidiIterator, Allocator, traits>::find_with_pike_vm(_narrow_type*, bool anchored, bool resumed)
+{
+   //
+   // Find the first match from position, and fill in the results from
+   // the slots the Pike VM recorded, if the VM can run this expression.
+   // The VM tries the same starting points as the find_restart_* routines.
+   // If resumed then nothing before position can match, and the search is
+   // already under way there:
+   //
+   if(m_match_flags & (match_partial | match_posix | match_extra))
+      return dfa_failed;
+   if((position == backstop) && (m_match_flags & match_prev_avail))
+      return dfa_failed;
+   pike_vm_lease<char_type, traits> vm(re.get_data(), m_presult->size());
+   if(vm.get() == 0)
+      return dfa_failed;
+   const unsigned char* map = 0;
+   bool check_first = true;
+   bool null_at_end = re.can_be_null();
+   switch(anchored ? static_cast<unsigned>(regbase::restart_continue) : re.get_restart_type())
+   {
+   case regbase::restart_any:
+      map = re.get_map();
+      break;
+   case regbase::restart_word:
+      map = re.get_map();
+      check_first = resumed || (position != base) || (m_match_flags & match_prev_avail);
+      null_at_end = false;
+      break;
+   case regbase::restart_line:
+      map = re.get_map();
+      check_first = resumed;
+      break;
+   case regbase::restart_buf:
+      anchored = true;
+      break;
+   case regbase::restart_continue:
+      break;
+   default:
+      // a literal prefix, and nothing shorter can match:
+      null_at_end = false;
+      break;
+   }
+   int r = vm.get()->find(backstop, position, last, search_base, m_match_flags, anchored, map, check_first, null_at_end);
+   if(r != dfa_matched)
+      return r;
+   const std::size_t* slots = vm.get()->result();
+   BidiIterator start(position), end(position);
+   std::advance(start, slots[0]);
+   std::advance(end, slots[1]);
+   m_presult->set_first(start);
+   for(std::size_t i = 1; i < m_presult->size(); ++i)
+   {
+      if((slots[2 * i] != pike_vm_npos) && (slots[2 * i + 1] != pike_vm_npos))
+      {
+         BidiIterator i1(position), i2(position);
+         std::advance(i1, slots[2 * i]);
+         std::advance(i2, slots[2 * i + 1]);
+         m_presult->set_first(i1, i);
+         m_presult->set_second(i2, i);
+      }
+   }
+   // the last sub-expression closed isn't necessarily the last one numerically:
+   std::size_t closed = vm.get()->last_closed();
+   if((closed != pike_vm_npos) && (closed < m_presult->size()))
+      m_presult->set_second((*m_presult)[static_cast<int>(closed)].second, closed);
+   m_presult->set_second(end);
+   position = end;
+   return dfa_matched;
+}
+
+template <class BidiIterator, class Allocator, class traits>
+inline int perl_matcher<BidiIterator, Allocator, traits>::find_with_pike_vm(_wide_type*, bool, bool)
+{
+   return dfa_failed;
 }
 
 } // namespace BOOST_REGEX_DETAIL_NS
@@ -94,10 +94,18 @@ struct saved_extra_block : public saved_state
 struct save_state_init
 {
    saved_state** stack;
-   save_state_init(saved_state** base, saved_state** end)
-      : stack(base)
+   void** cache;
+   save_state_init(saved_state** base, saved_state** end, void** block_cache = 0)
+      : stack(base), cache(block_cache)
    {
-      *base = static_cast<saved_state*>(get_mem_block());
+      if(cache && *cache)
+      {
+         // reuse the block the last match left in the cache:
+         *base = static_cast<saved_state*>(*cache);
+         *cache = 0;
+      }
+      else
+         *base = static_cast<saved_state*>(get_mem_block());
       *end = reinterpret_cast<saved_state*>(reinterpret_cast<char*>(*base)+BOOST_REGEX_BLOCKSIZE);
       --(*end);
       (void) new (*end)saved_state(0);
@@ -105,7 +113,10 @@ struct save_state_init
    }
    ~save_state_init()
    {
-      put_mem_block(*stack);
+      if(cache && !*cache)
+         *cache = *stack;
+      else
+         put_mem_block(*stack);
       *stack = 0;
    }
 };
@@ -560,8 +571,8 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_alt()
    }
    else
    {
-      take_first = can_start(*position, jmp->_map, (unsigned char)mask_take);
-      take_second = can_start(*position, jmp->_map, (unsigned char)mask_skip);
+      take_first = can_start(*position, jmp->_take_map);
+      take_second = can_start(*position, jmp->_skip_map);
   }
 
    if(take_first)
@@ -604,8 +615,8 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_rep()
    }
    else
    {
-      take_first = can_start(*position, rep->_map, (unsigned char)mask_take);
-      take_second = can_start(*position, rep->_map, (unsigned char)mask_skip);
+      take_first = can_start(*position, rep->_take_map);
+      take_second = can_start(*position, rep->_skip_map);
    }
 
    if((m_backup_state->state_id != saved_state_repeater_count) 
@@ -719,7 +730,12 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_slow()
          restart = position;
       // push backtrack info if available:
       if(count - rep->min)
-         push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+      {
+         if(!rep->possessive || (m_match_flags & match_partial))
+            push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+         else
+            state_count += count - rep->min;  // what unwinding would have cost, so the complexity limit still applies
+      }
       // jump to next state:
       pstate = rep->alt.p;
       return true;
@@ -730,27 +746,40 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_slow()
       if(count < rep->max)
          push_single_repeat(count, rep, position, saved_state_rep_slow_dot);
       pstate = rep->alt.p;
-      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_map, mask_skip);
+      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_skip_map);
    }
 }
 
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_fast()
 {
-   if(m_match_flags & match_not_dot_null)
-      return match_dot_repeat_slow();
-   if((static_cast<const re_dot*>(pstate->next.p)->mask & match_any_mask) == 0)
-      return match_dot_repeat_slow();
-
    const re_repeat* rep = static_cast<const re_repeat*>(pstate);
    bool greedy = (rep->greedy) && (!(m_match_flags & regex_constants::match_any) || m_independent);   
    std::size_t count = static_cast<std::size_t>((std::min)(static_cast<std::size_t>(std::distance(position, last)), greedy ? rep->max : rep->min));
-   if(rep->min > count)
+   // whether the wildcard can fail to match some characters:
+   bool not_separator = (static_cast<const re_dot*>(pstate->next.p)->mask & match_any_mask) == 0;
+   bool not_null = (m_match_flags & match_not_dot_null) != 0;
+   bool restricted = not_separator || not_null;
+   if(restricted)
+   {
+      // stop at the first character the wildcard doesn't match:
+      BidiIterator end = position;
+      std::advance(end, count);
+      BidiIterator origin(position);
+      position = skip_wild(position, end, not_separator, not_null);
+      count = static_cast<std::size_t>(std::distance(origin, position));
+      if(rep->min > count)
+         return false;
+   }
+   else
    {
-      position = last;
-      return false;  // not enough text left to match
+      if(rep->min > count)
+      {
+         position = last;
+         return false;  // not enough text left to match
+      }
+      std::advance(position, count);
    }
-   std::advance(position, count);
 
    if(greedy)
    {
@@ -758,7 +787,12 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_fast()
          restart = position;
       // push backtrack info if available:
       if(count - rep->min)
-         push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+      {
+         if(!rep->possessive || (m_match_flags & match_partial))
+            push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+         else
+            state_count += count - rep->min;  // what unwinding would have cost, so the complexity limit still applies
+      }
       // jump to next state:
       pstate = rep->alt.p;
       return true;
@@ -767,9 +801,9 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_dot_repeat_fast()
    {
       // non-greedy, push state and return true if we can skip:
       if(count < rep->max)
-         push_single_repeat(count, rep, position, saved_state_rep_fast_dot);
+         push_single_repeat(count, rep, position, restricted ? saved_state_rep_slow_dot : saved_state_rep_fast_dot);
       pstate = rep->alt.p;
-      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_map, mask_skip);
+      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_skip_map);
    }
 }
 
@@ -803,10 +837,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat()
       else
          std::advance(end, desired);
       BidiIterator origin(position);
-      while((position != end) && (traits_inst.translate(*position, icase) == what))
-      {
-         ++position;
-      }
+      position = skip_char(position, end, what, traits_inst, icase, re.get_data().m_raw_chars);
       count = (unsigned)std::distance(origin, position);
    }
    else
@@ -827,7 +858,12 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat()
          restart = position;
       // push backtrack info if available:
       if(count - rep->min)
-         push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+      {
+         if(!rep->possessive || (m_match_flags & match_partial))
+            push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+         else
+            state_count += count - rep->min;  // what unwinding would have cost, so the complexity limit still applies
+      }
       // jump to next state:
       pstate = rep->alt.p;
       return true;
@@ -838,7 +874,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_char_repeat()
       if(count < rep->max)
          push_single_repeat(count, rep, position, saved_state_rep_char);
       pstate = rep->alt.p;
-      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_map, mask_skip);
+      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_skip_map);
    }
 #ifdef BOOST_BORLANDC
 #pragma option pop
@@ -859,7 +895,8 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
 #pragma option push -w-8008 -w-8066 -w-8004
 #endif
    const re_repeat* rep = static_cast<const re_repeat*>(pstate);
-   const unsigned char* map = static_cast<const re_set*>(rep->next.p)->_map;
+   const re_set* set = static_cast<const re_set*>(rep->next.p);
+   const re_bitmap& map = set->_map;
    std::size_t count = 0;
    //
    // start by working out how much we can skip:
@@ -877,15 +914,12 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
       else
          std::advance(end, desired);
       BidiIterator origin(position);
-      while((position != end) && map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
-      {
-         ++position;
-      }
+      position = skip_set(position, end, set, traits_inst, icase);
       count = (unsigned)std::distance(origin, position);
    }
    else
    {
-      while((count < desired) && (position != last) && map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+      while((count < desired) && (position != last) && map.test(static_cast<unsigned char>(traits_inst.translate(*position, icase))))
       {
          ++position;
          ++count;
@@ -901,7 +935,12 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
          restart = position;
       // push backtrack info if available:
       if(count - rep->min)
-         push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+      {
+         if(!rep->possessive || (m_match_flags & match_partial))
+            push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+         else
+            state_count += count - rep->min;  // what unwinding would have cost, so the complexity limit still applies
+      }
       // jump to next state:
       pstate = rep->alt.p;
       return true;
@@ -912,7 +951,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_set_repeat()
       if(count < rep->max)
          push_single_repeat(count, rep, position, saved_state_rep_short_set);
       pstate = rep->alt.p;
-      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_map, mask_skip);
+      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_skip_map);
    }
 #ifdef BOOST_BORLANDC
 #pragma option pop
@@ -976,7 +1015,12 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_long_set_repeat()
          restart = position;
       // push backtrack info if available:
       if(count - rep->min)
-         push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+      {
+         if(!rep->possessive || (m_match_flags & match_partial))
+            push_single_repeat(count, rep, position, saved_state_greedy_single_repeat);
+         else
+            state_count += count - rep->min;  // what unwinding would have cost, so the complexity limit still applies
+      }
       // jump to next state:
       pstate = rep->alt.p;
       return true;
@@ -987,7 +1031,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_long_set_repeat()
       if(count < rep->max)
          push_single_repeat(count, rep, position, saved_state_rep_long_set);
       pstate = rep->alt.p;
-      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_map, mask_skip);
+      return (position == last) ? (rep->can_be_null & mask_skip) : can_start(*position, rep->_skip_map);
    }
 #ifdef BOOST_BORLANDC
 #pragma option pop
@@ -1395,19 +1439,48 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_greedy_single_repeat(
    BOOST_REGEX_ASSERT(count);
    position = pmp->last_position;
 
+   if(rep->following_literal && ::boost::is_random_access_iterator<BidiIterator>::value && !(m_match_flags & match_partial))
+   {
+      // back up straight to the last place the literal after the repeat matches:
+      const re_literal* lit = reinterpret_cast<const re_literal*>(reinterpret_cast<const char*>(rep) + rep->following_literal);
+      BidiIterator base = position;
+      std::advance(base, -static_cast<std::ptrdiff_t>(count));
+      BidiIterator found = rfind_literal(base, position, last, reinterpret_cast<const char_type*>(lit + 1), lit->length, traits_inst, icase, re.get_data().m_raw_chars);
+      // count each character skipped, as the loop below would have done:
+      if(found == position)
+      {
+         state_count += count;
+         destroy_single_repeat();
+         return true;
+      }
+      std::size_t skipped = static_cast<std::size_t>(std::distance(found, position));
+      state_count += skipped;
+      count -= skipped;
+      position = found;
+      if(count == 0)
+         destroy_single_repeat();
+      else
+      {
+         pmp->count = count + rep->min;
+         pmp->last_position = position;
+      }
+      pstate = rep->alt.p;
+      return false;
+   }
+
    // backtrack till we can skip out:
    do
    {
       --position;
       --count;
       ++state_count;
-   }while(count && !can_start(*position, rep->_map, mask_skip));
+   }while(count && !can_start(*position, rep->_skip_map));
 
    // if we've hit base, destroy this state:
    if(count == 0)
    {
          destroy_single_repeat();
-         if(!can_start(*position, rep->_map, mask_skip))
+         if(!can_start(*position, rep->_skip_map))
             return true;
    }
    else
@@ -1456,7 +1529,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_slow_dot_repeat(bool
          ++count;
          ++state_count;
          pstate = rep->next.p;
-      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_map, mask_skip));
+      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_skip_map));
    }   
    if(position == last)
    {
@@ -1471,7 +1544,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_slow_dot_repeat(bool
    {
       // can't repeat any more, remove the pushed state: 
       destroy_single_repeat();
-      if(!can_start(*position, rep->_map, mask_skip))
+      if(!can_start(*position, rep->_skip_map))
          return true;
    }
    else
@@ -1509,7 +1582,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_fast_dot_repeat(bool
          ++position;
          ++count;
          ++state_count;
-      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_map, mask_skip));
+      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_skip_map));
    }
 
    // remember where we got to if this is a leading repeat:
@@ -1528,7 +1601,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_fast_dot_repeat(bool
    {
       // can't repeat any more, remove the pushed state: 
       destroy_single_repeat();
-      if(!can_start(*position, rep->_map, mask_skip))
+      if(!can_start(*position, rep->_skip_map))
          return true;
    }
    else
@@ -1579,7 +1652,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_char_repeat(bool r)
          ++ position;
          ++state_count;
          pstate = rep->next.p;
-      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_map, mask_skip));
+      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_skip_map));
    }   
    // remember where we got to if this is a leading repeat:
    if((rep->leading) && (count < rep->max))
@@ -1597,7 +1670,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_char_repeat(bool r)
    {
       // can't repeat any more, remove the pushed state: 
       destroy_single_repeat();
-      if(!can_start(*position, rep->_map, mask_skip))
+      if(!can_start(*position, rep->_skip_map))
          return true;
    }
    else
@@ -1624,7 +1697,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_short_set_repeat(bool
    const re_repeat* rep = pmp->rep;
    std::size_t count = pmp->count;
    pstate = rep->next.p;
-   const unsigned char* map = static_cast<const re_set*>(rep->next.p)->_map;
+   const re_bitmap& map = static_cast<const re_set*>(rep->next.p)->_map;
    position = pmp->last_position;
 
    BOOST_REGEX_ASSERT(rep->type == syntax_element_short_set_rep);
@@ -1638,7 +1711,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_short_set_repeat(bool
       // wind forward until we can skip out of the repeat:
       do
       {
-         if(!map[static_cast<unsigned char>(traits_inst.translate(*position, icase))])
+         if(!map.test(static_cast<unsigned char>(traits_inst.translate(*position, icase))))
          {
             // failed repeat match, discard this state and look for another:
             destroy_single_repeat();
@@ -1648,7 +1721,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_short_set_repeat(bool
          ++ position;
          ++state_count;
          pstate = rep->next.p;
-      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_map, mask_skip));
+      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_skip_map));
    }   
    // remember where we got to if this is a leading repeat:
    if((rep->leading) && (count < rep->max))
@@ -1666,7 +1739,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_short_set_repeat(bool
    {
       // can't repeat any more, remove the pushed state: 
       destroy_single_repeat();
-      if(!can_start(*position, rep->_map, mask_skip))
+      if(!can_start(*position, rep->_skip_map))
          return true;
    }
    else
@@ -1718,7 +1791,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_long_set_repeat(bool
          ++count;
          ++state_count;
          pstate = rep->next.p;
-      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_map, mask_skip));
+      }while((count < rep->max) && (position != last) && !can_start(*position, rep->_skip_map));
    }   
    // remember where we got to if this is a leading repeat:
    if((rep->leading) && (count < rep->max))
@@ -1736,7 +1809,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_long_set_repeat(bool
    {
       // can't repeat any more, remove the pushed state: 
       destroy_single_repeat();
-      if(!can_start(*position, rep->_map, mask_skip))
+      if(!can_start(*position, rep->_skip_map))
          return true;
    }
    else
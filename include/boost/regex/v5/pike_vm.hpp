@@ -0,0 +1,454 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         pike_vm.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares class pike_vm, which finds matches of narrow
+  *                character expressions, along with their sub-expressions,
+  *                in time proportional to the length of the input.
+  */
+
+#ifndef BOOST_REGEX_V5_PIKE_VM_HPP
+#define BOOST_REGEX_V5_PIKE_VM_HPP
+
+#include <boost/regex/v5/lazy_dfa.hpp>
+
+namespace boost{
+namespace BOOST_REGEX_DETAIL_NS{
+
+//
+// The value of a slot which hasn't been set:
+//
+static const std::size_t pike_vm_npos = ~static_cast<std::size_t>(0);
+
+/*** class pike_vm ****************************************************
+Runs a dfa_program as a Pike VM: all the threads that are still alive
+at each position are kept in a list in priority order, each thread
+carrying its own copy of the capture slots.  When two threads reach
+the same node at the same position only the one with the higher
+priority is kept (but see dfa_visits), which gives the same
+leftmost-first result as the backtracking matcher without ever looking
+at a character twice.  Branches only go the ways that the program's
+branch rows allow, and matches only start where perl_matcher would
+try them, so that the start maps which prune the backtracking
+matcher's search prune this one in just the same way.
+
+Slots are offsets from the start of the search: slot 0 is the start
+of the match, slots 2i and 2i+1 the start and end of sub-expression i,
+and the final slot records the last sub-expression to be closed.
+***********************************************************************/
+class pike_vm
+{
+public:
+   pike_vm() : m_program(0), m_slots(0), m_entered(0), m_matched(false), m_flags(regex_constants::match_default) {}
+
+   //
+   // Prepares to run program, recording sub-expressions [0, groups):
+   //
+   void init(const dfa_program* program, std::size_t groups)
+   {
+      std::size_t slots = 2 * groups + 1;
+      if((program == m_program) && (slots == m_slots))
+         return;
+      m_program = program;
+      m_slots = slots;
+      m_lists[0].resize(program->m_nodes.size(), slots);
+      m_lists[1].resize(program->m_nodes.size(), slots);
+      m_work.assign(slots, pike_vm_npos);
+      m_best.assign(slots, pike_vm_npos);
+   }
+   //
+   // Finds the first match starting in [first, last), or starting at
+   // first only if anchored.  Otherwise a match may start anywhere the
+   // start map allows (anywhere at all if map is null), or at last if
+   // null_at_end, and at first regardless if check_first is false.
+   // base is where match_not_initial_null measures from.  Returns
+   // dfa_failed if more paths reach some node than we can keep track
+   // of.  The caller must check that first isn't backstop when
+   // match_prev_avail is set, as there's no telling what's before:
+   //
+   template <class BidiIterator>
+   int find(BidiIterator backstop, BidiIterator first, BidiIterator last, BidiIterator base, match_flag_type f, bool anchored, const unsigned char* map, bool check_first, bool null_at_end)
+   {
+      // there's no telling which starts perl_matcher would skip:
+      if(!anchored && m_program->skips_starts(f))
+         return dfa_failed;
+      const unsigned edge = m_program->m_class_count;
+      const unsigned char* classes = m_program->m_classes;
+      unsigned before = edge;
+      if(first != backstop)
+      {
+         BidiIterator prev(first);
+         --prev;
+         before = classes[static_cast<unsigned char>(*prev)];
+      }
+      const bool not_null = (f & regex_constants::match_not_null) != 0;
+      const bool must_end = (f & regex_constants::match_all) != 0;
+      const std::size_t base_offset = ((f & regex_constants::match_not_initial_null) && (base == first)) ? 0 : pike_vm_npos;
+      list_type* current = &m_lists[0];
+      list_type* next = &m_lists[1];
+      current->clear();
+      m_matched = false;
+      m_flags = f;
+
+      BidiIterator position(first);
+      std::size_t offset = 0;
+      unsigned after = position == last ? edge : classes[static_cast<unsigned char>(*position)];
+      while(true)
+      {
+         if(!m_matched && (!anchored || (offset == 0)))
+         {
+            bool start = anchored || (!check_first && (offset == 0));
+            if(!start && current->empty() && map)
+            {
+               // nothing in progress: skip anything that can't start a match:
+               while((position != last) && !(map[static_cast<unsigned char>(*position)] & mask_any))
+               {
+                  before = classes[static_cast<unsigned char>(*position)];
+                  ++position;
+                  ++offset;
+               }
+               after = position == last ? edge : classes[static_cast<unsigned char>(*position)];
+               // anything visited before was visited at another position:
+               current->clear();
+            }
+            if(!start)
+               start = position == last ? null_at_end : (!map || (map[static_cast<unsigned char>(*position)] & mask_any));
+            if(start)
+            {
+               // start a new thread, with lower priority than any already running:
+               std::fill(m_work.begin(), m_work.end(), pike_vm_npos);
+               m_work[0] = offset;
+               add_thread(*current, m_program->m_start, offset, before, after);
+               if(current->overflowed())
+                  return dfa_failed;
+            }
+         }
+         if(current->empty() && (m_matched || anchored || (position == last)))
+            break;
+         BidiIterator following(position);
+         unsigned next_after = edge;
+         if(position != last)
+         {
+            ++following;
+            next_after = following == last ? edge : classes[static_cast<unsigned char>(*following)];
+         }
+         next->clear();
+         for(std::size_t i = 0; i < current->size(); ++i)
+         {
+            const dfa_node& n = m_program->m_nodes[current->node(i)];
+            const std::size_t* caps = current->slots(i);
+            if(n.type == dfa_match)
+            {
+               if((not_null && (caps[0] == offset)) || (must_end && (position != last)) || (offset == base_offset))
+                  continue;
+               // this match beats everything after it in the list:
+               std::copy(caps, caps + m_slots, m_best.begin());
+               m_best[1] = offset;
+               m_matched = true;
+               break;
+            }
+            if((position != last) && m_program->accepts(n, after, f))
+            {
+               std::copy(caps, caps + m_slots, m_work.begin());
+               add_thread(*next, n.next, offset + 1, after, next_after);
+            }
+         }
+         if(next->overflowed())
+            return dfa_failed;
+         if(position == last)
+            break;
+         std::swap(current, next);
+         before = after;
+         after = next_after;
+         position = following;
+         ++offset;
+      }
+      return m_matched ? dfa_matched : dfa_no_match;
+   }
+   //
+   // The slots of the match found, slot 1 being where it ends:
+   //
+   const std::size_t* result()const
+   {
+      return &m_best[0];
+   }
+   std::size_t last_closed()const
+   {
+      return m_best[m_slots - 1];
+   }
+
+private:
+   //
+   // A sparse set of the threads at one position, in priority order:
+   //
+   class list_type
+   {
+   public:
+      list_type() : m_size(0), m_slot_count(0) {}
+      void resize(std::size_t nodes, std::size_t slots)
+      {
+         m_visits.resize(nodes);
+         m_nodes.resize(nodes);
+         m_slots.resize(nodes * slots);
+         m_slot_count = slots;
+         m_size = 0;
+      }
+      void clear()
+      {
+         m_size = 0;
+         m_visits.clear();
+      }
+      // returns false if there's no need to visit node again:
+      bool visit(unsigned node, std::uint64_t entered)
+      {
+         return m_visits.visit(node, entered);
+      }
+      // whether some paths were lost because a node was visited too often:
+      bool overflowed()const
+      {
+         return m_visits.overflowed();
+      }
+      void push_back(unsigned node, const std::vector<std::size_t>& slots)
+      {
+         m_nodes[m_size] = node;
+         std::copy(slots.begin(), slots.end(), m_slots.begin() + m_size * m_slot_count);
+         ++m_size;
+      }
+      bool empty()const { return m_size == 0; }
+      std::size_t size()const { return m_size; }
+      unsigned node(std::size_t i)const { return m_nodes[i]; }
+      const std::size_t* slots(std::size_t i)const { return &m_slots[i * m_slot_count]; }
+   private:
+      dfa_visits               m_visits;      // nodes visited at this position
+      std::vector<unsigned>    m_nodes;       // node of each thread
+      std::vector<std::size_t> m_slots;       // slots of each thread
+      std::size_t              m_size;        // number of threads
+      std::size_t              m_slot_count;
+   };
+
+   enum job_type
+   {
+      job_visit,             // visit node
+      job_restore,           // put value back in slot node
+      job_leave              // repeat node is no longer on the current path
+   };
+   struct job
+   {
+      job_type    type;
+      unsigned    node;
+      std::size_t value;
+   };
+
+   //
+   // Follows everything that can be reached from node without consuming
+   // a character, in priority order, adding the threads that are
+   // waiting on a character (or have matched) to list.  m_work holds
+   // the slots of the thread that got us here, and m_entered the
+   // repeats started along the current path, which can only have
+   // matched nothing so far:
+   //
+   void add_thread(list_type& list, unsigned node, std::size_t offset, unsigned before, unsigned after)
+   {
+      job j = { job_visit, node, 0 };
+      m_stack.push_back(j);
+      while(!m_stack.empty())
+      {
+         j = m_stack.back();
+         m_stack.pop_back();
+         if(j.type == job_restore)
+         {
+            m_work[j.node] = j.value;
+            continue;
+         }
+         if(j.type == job_leave)
+         {
+            m_entered &= ~dfa_visits::repeat_bit(static_cast<int>(j.node));
+            continue;
+         }
+         unsigned id = j.node;
+         while(true)
+         {
+            const dfa_node& n = m_program->m_nodes[id];
+            const bool consumes = (n.type == dfa_char) || (n.type == dfa_dot) || (n.type == dfa_match);
+            if(!list.visit(id, consumes ? 0 : m_entered))
+               break;
+            if(n.type == dfa_split)
+            {
+               // go whichever ways the branch allows, the preferred one first:
+               const unsigned ways = m_program->ways(n, after, m_flags);
+               const bool alt_first = (ways & dfa_way_alt_first) != 0;
+               if(ways & (alt_first ? dfa_way_next : dfa_way_alt))
+               {
+                  job other = { job_visit, alt_first ? n.next : n.alt, 0 };
+                  m_stack.push_back(other);
+               }
+               if((ways & (alt_first ? dfa_way_alt : dfa_way_next)) == 0)
+                  break;
+               id = alt_first ? n.alt : n.next;
+            }
+            else if(n.type == dfa_epsilon)
+            {
+               if((n.arg >= 0) && (static_cast<std::size_t>(n.arg) < m_slots - 1))
+               {
+                  job r = { job_restore, static_cast<unsigned>(n.arg), m_work[n.arg] };
+                  m_stack.push_back(r);
+                  m_work[n.arg] = offset;
+                  if(n.arg & 1)
+                  {
+                     job lc = { job_restore, static_cast<unsigned>(m_slots - 1), m_work[m_slots - 1] };
+                     m_stack.push_back(lc);
+                     m_work[m_slots - 1] = static_cast<std::size_t>(n.arg / 2);
+                  }
+               }
+               id = n.next;
+            }
+            else if(n.type == dfa_assert)
+            {
+               if(!m_program->check(n.arg, before, after, m_flags))
+                  break;
+               id = n.next;
+            }
+            else if(n.type == dfa_repeat)
+            {
+               if((m_entered & dfa_visits::repeat_bit(n.arg)) == 0)
+               {
+                  job l = { job_leave, static_cast<unsigned>(n.arg), 0 };
+                  m_stack.push_back(l);
+                  m_entered |= dfa_visits::repeat_bit(n.arg);
+               }
+               id = n.next;
+            }
+            else if(n.type == dfa_loop)
+            {
+               id = m_entered & dfa_visits::repeat_bit(n.arg) ? n.alt : n.next;
+            }
+            else
+            {
+               if(n.type != dfa_fail)
+                  list.push_back(id, m_work);
+               break;
+            }
+         }
+      }
+   }
+
+   pike_vm(const pike_vm&);
+   pike_vm& operator=(const pike_vm&);
+
+   const dfa_program*       m_program;
+   std::size_t              m_slots;         // slots per thread
+   list_type                m_lists[2];      // threads at this position and the next
+   std::vector<std::size_t> m_work;          // slots of the thread being followed
+   std::vector<std::size_t> m_best;          // slots of the best match so far
+   std::vector<job>         m_stack;         // work still to do in add_thread
+   std::uint64_t            m_entered;       // repeats started on the current path of add_thread
+   bool                     m_matched;
+   match_flag_type          m_flags;
+};
+
+/*** class machine_pool ***********************************************
+Keeps the matching machines (pike_vm's and the like) that aren't
+currently in use, so that their memory can be reused by the next
+search.  Like lazy_dfa_pool, machines are borrowed and returned with
+an atomic operation apiece, and any that don't fit are deleted.
+***********************************************************************/
+template <class Machine>
+class machine_pool
+{
+public:
+   machine_pool()
+   {
+      for(std::size_t i = 0; i < spare_count; ++i)
+         m_spare[i].store(nullptr);
+   }
+   ~machine_pool()
+   {
+      for(std::size_t i = 0; i < spare_count; ++i)
+         delete m_spare[i].load();
+   }
+
+   Machine* acquire()const
+   {
+      for(std::size_t i = 0; i < spare_count; ++i)
+      {
+         Machine* p = m_spare[i].load();
+         if(p && m_spare[i].compare_exchange_strong(p, nullptr))
+            return p;
+      }
+      return new Machine();
+   }
+   void release(Machine* p)const
+   {
+      for(std::size_t i = 0; i < spare_count; ++i)
+      {
+         Machine* empty = m_spare[i].load();
+         if(!empty && m_spare[i].compare_exchange_strong(empty, p))
+            return;
+      }
+      delete p;
+   }
+
+private:
+   machine_pool(const machine_pool&);
+   machine_pool& operator=(const machine_pool&);
+
+   static const std::size_t spare_count = 8;
+
+   mutable std::atomic<Machine*> m_spare[spare_count];   // machines not currently in use
+};
+
+//
+// Owned by each regex_data:
+//
+typedef machine_pool<pike_vm> pike_vm_pool;
+
+/*** class pike_vm_lease **********************************************
+Borrows a pike_vm, set up to run the expression's program, for the
+duration of one search; get() is null if the expression has no
+program.
+***********************************************************************/
+template <class charT, class traits>
+class pike_vm_lease
+{
+public:
+   pike_vm_lease(const regex_data<charT, traits>& data, std::size_t groups)
+      : m_pool(data.m_pike_vms), m_vm(0)
+   {
+      const dfa_program* program = data.m_dfa.program(data);
+      if(program)
+      {
+         m_vm = m_pool.acquire();
+         m_vm->init(program, groups);
+      }
+   }
+   ~pike_vm_lease()
+   {
+      if(m_vm)
+         m_pool.release(m_vm);
+   }
+   pike_vm* get()const
+   {
+      return m_vm;
+   }
+private:
+   pike_vm_lease(const pike_vm_lease&);
+   pike_vm_lease& operator=(const pike_vm_lease&);
+
+   const pike_vm_pool& m_pool;
+   pike_vm*            m_vm;
+};
+
+} // namespace BOOST_REGEX_DETAIL_NS
+} // namespace boost
+
+#endif
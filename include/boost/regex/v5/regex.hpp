@@ -36,6 +36,10 @@
 #include <boost/regex/v5/char_regex_traits.hpp>
 #include <boost/regex/v5/states.hpp>
 #include <boost/regex/v5/regbase.hpp>
+#include <boost/regex/v5/literal_search.hpp>
+#include <boost/regex/v5/startmap_search.hpp>
+#include <boost/regex/v5/lazy_dfa.hpp>
+#include <boost/regex/v5/pike_vm.hpp>
 #include <boost/regex/v5/basic_regex.hpp>
 #include <boost/regex/v5/basic_regex_creator.hpp>
 #include <boost/regex/v5/basic_regex_parser.hpp>
@@ -43,6 +47,7 @@
 #include <boost/regex/v5/regex_format.hpp>
 #include <boost/regex/v5/match_results.hpp>
 #include <boost/regex/v5/perl_matcher.hpp>
+#include <boost/regex/v5/regex_match_context.hpp>
 
 namespace boost{
 #ifdef BOOST_REGEX_NO_FWD
@@ -69,6 +74,10 @@ typedef match_results<std::wstring::const_iterator> wsmatch;
 #include <boost/regex/v5/regex_replace.hpp>
 #include <boost/regex/v5/regex_merge.hpp>
 #include <boost/regex/v5/regex_split.hpp>
+#include <boost/regex/v5/regex_set.hpp>
+#include <boost/regex/v5/parallel_regex_search.hpp>
+#include <boost/regex/v5/regex_serialize.hpp>
+#include <boost/regex/v5/regex_cache.hpp>
 
 #endif  // __cplusplus
 
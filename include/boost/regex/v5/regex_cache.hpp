@@ -0,0 +1,351 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         regex_cache.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares template class basic_regex_cache, which hands
+  *                out shared compiled expressions keyed on their text
+  *                and flags.
+  *                Note this is an internal header file included
+  *                by regex.hpp, do not include on its own.
+  */
+
+#ifndef BOOST_REGEX_V5_REGEX_CACHE_HPP
+#define BOOST_REGEX_V5_REGEX_CACHE_HPP
+
+#include <boost/regex/v5/object_cache.hpp>
+
+namespace boost{
+
+namespace BOOST_REGEX_DETAIL_NS{
+
+static const std::size_t regex_cache_default_shards = 16;
+
+//
+// An expression held by the cache, these are never changed once they're
+// in a table, other than to record when they were last used:
+//
+template <class charT, class traits>
+struct regex_cache_entry
+{
+   typedef basic_regex<charT, traits> regex_type;
+
+   std::basic_string<charT>           pattern;
+   typename regex_type::flag_type     flags;
+   std::size_t                        hash;
+   std::size_t                        bytes;     // regex->memory_usage()
+   std::shared_ptr<const regex_type>  regex;
+   mutable std::atomic<std::uint64_t> last_used; // the cache's clock when last found
+
+   bool is(const charT* p1, const charT* p2, typename regex_type::flag_type f, std::size_t h)const
+   {
+      return (hash == h) && (flags == f) && (pattern.size() == static_cast<std::size_t>(p2 - p1))
+         && std::equal(p1, p2, pattern.begin());
+   }
+};
+
+template <class charT>
+std::size_t regex_cache_hash(const charT* p1, const charT* p2, unsigned f)
+{
+   // FNV-1a, one character at a time:
+   std::uint64_t h = 14695981039346656037uLL ^ f;
+   for(; p1 != p2; ++p1)
+   {
+      h ^= static_cast<std::uint64_t>(*p1);
+      h *= 1099511628211uLL;
+   }
+   return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+/*** class regex_cache_shard ******************************************
+One slice of the cache: a table of entries sorted by hash which is
+never changed once published, so that lookups can search it without
+taking a lock.  Writers, one at a time, copy the table, change the
+copy and publish it, and then wait for m_readers to be sure nobody is
+still looking at the old table before freeing it.
+***********************************************************************/
+template <class charT, class traits>
+class regex_cache_shard
+{
+public:
+   typedef regex_cache_entry<charT, traits>         entry_type;
+   typedef std::vector<std::shared_ptr<entry_type> > table_type;
+   typedef basic_regex<charT, traits>               regex_type;
+   typedef typename regex_type::flag_type           flag_type;
+
+   regex_cache_shard()
+      : m_table(0), m_size(0), m_bytes(0), m_hits(0), m_misses(0), m_evictions(0) {}
+   ~regex_cache_shard()
+   {
+      delete m_table.load();
+   }
+
+   std::shared_ptr<const regex_type> find(const charT* p1, const charT* p2, flag_type f, std::size_t h, std::uint64_t now)const
+   {
+      std::shared_ptr<const regex_type> result;
+      unsigned slot = m_readers.enter();
+      const table_type* table = m_table.load();
+      if(table)
+      {
+         const entry_type* e = find(*table, p1, p2, f, h);
+         if(e)
+         {
+            // only write to the entry when the clock has moved on, so that
+            // threads using the same expression don't fight over it:
+            if(e->last_used.load(std::memory_order_relaxed) != now)
+               e->last_used.store(now, std::memory_order_relaxed);
+            result = e->regex;
+         }
+      }
+      m_readers.leave(slot);
+      (result ? m_hits : m_misses).fetch_add(1, std::memory_order_relaxed);
+      return result;
+   }
+
+   //
+   // Adds e unless another thread got there first, in which case the
+   // expression already cached is returned instead; then evicts the
+   // least recently used entries until the shard is within its limits:
+   //
+   std::shared_ptr<const regex_type> insert(const std::shared_ptr<entry_type>& e, std::size_t max_size, std::size_t max_bytes)
+   {
+#ifdef BOOST_HAS_THREADS
+      std::lock_guard<std::mutex> l(m_writer);
+#endif
+      const table_type* old = m_table.load();
+      if(old)
+      {
+         const entry_type* existing = find(*old, e->pattern.data(), e->pattern.data() + e->pattern.size(), e->flags, e->hash);
+         if(existing)
+            return existing->regex;
+      }
+      std::unique_ptr<table_type> table(old ? new table_type(*old) : new table_type());
+      typename table_type::iterator pos = table->begin();
+      while((pos != table->end()) && ((*pos)->hash <= e->hash))
+         ++pos;
+      table->insert(pos, e);
+      std::size_t bytes = m_bytes.load(std::memory_order_relaxed) + e->bytes;
+      std::size_t evicted = 0;
+      while((table->size() > 1) && ((max_size && (table->size() > max_size)) || (max_bytes && (bytes > max_bytes))))
+      {
+         typename table_type::iterator victim = table->end();
+         for(typename table_type::iterator i = table->begin(); i != table->end(); ++i)
+         {
+            if((*i != e) && ((victim == table->end()) || ((*i)->last_used.load(std::memory_order_relaxed) < (*victim)->last_used.load(std::memory_order_relaxed))))
+               victim = i;
+         }
+         bytes -= (*victim)->bytes;
+         table->erase(victim);
+         ++evicted;
+      }
+      m_size.store(table->size(), std::memory_order_relaxed);
+      m_bytes.store(bytes, std::memory_order_relaxed);
+      m_evictions.fetch_add(evicted, std::memory_order_relaxed);
+      m_table.store(table.release());
+      retire(old);
+      return e->regex;
+   }
+
+   void clear()
+   {
+#ifdef BOOST_HAS_THREADS
+      std::lock_guard<std::mutex> l(m_writer);
+#endif
+      const table_type* old = m_table.load();
+      m_table.store(0);
+      m_size.store(0, std::memory_order_relaxed);
+      m_bytes.store(0, std::memory_order_relaxed);
+      retire(old);
+   }
+
+   std::size_t size()const { return m_size.load(std::memory_order_relaxed); }
+   std::size_t bytes()const { return m_bytes.load(std::memory_order_relaxed); }
+   std::size_t hits()const { return m_hits.load(std::memory_order_relaxed); }
+   std::size_t misses()const { return m_misses.load(std::memory_order_relaxed); }
+   std::size_t evictions()const { return m_evictions.load(std::memory_order_relaxed); }
+
+private:
+   regex_cache_shard(const regex_cache_shard&);
+   regex_cache_shard& operator=(const regex_cache_shard&);
+
+   static const entry_type* find(const table_type& table, const charT* p1, const charT* p2, flag_type f, std::size_t h)
+   {
+      std::size_t first = 0;
+      std::size_t last = table.size();
+      while(first < last)
+      {
+         std::size_t mid = first + (last - first) / 2;
+         if((table[mid]->hash) < h)
+            first = mid + 1;
+         else
+            last = mid;
+      }
+      for(; (first < table.size()) && (table[first]->hash == h); ++first)
+      {
+         if(table[first]->is(p1, p2, f, h))
+            return table[first].get();
+      }
+      return 0;
+   }
+
+   // Frees a table once no reader can still be using it, called by the writer:
+   void retire(const table_type* old)
+   {
+      if(!old)
+         return;
+      m_readers.wait();
+      delete old;
+   }
+
+   std::atomic<const table_type*>   m_table;
+   table_readers                    m_readers;
+   std::atomic<std::size_t>         m_size;
+   std::atomic<std::size_t>         m_bytes;
+   mutable std::atomic<std::size_t> m_hits;
+   mutable std::atomic<std::size_t> m_misses;
+   std::atomic<std::size_t>         m_evictions;
+#ifdef BOOST_HAS_THREADS
+   std::mutex                       m_writer;
+#endif
+};
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
+//
+// How well a basic_regex_cache is doing:
+//
+struct regex_cache_statistics
+{
+   std::size_t hits;       // lookups which found the expression already compiled
+   std::size_t misses;     // lookups which had to compile it
+   std::size_t evictions;  // expressions dropped to keep within the limits
+   std::size_t size;       // expressions currently held
+   std::size_t bytes;      // their memory_usage() in total
+
+   double hit_rate()const
+   {
+      std::size_t total = hits + misses;
+      return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+   }
+};
+
+/*** class basic_regex_cache ******************************************
+Hands out compiled expressions keyed on their text and flags, compiling
+each only on its first use.  Entries are spread over a number of shards
+by hash, each shard keeping its share of the limits and dropping its
+least recently used entries when it goes over them.
+***********************************************************************/
+template <class charT, class traits = regex_traits<charT> >
+class basic_regex_cache
+{
+   typedef BOOST_REGEX_DETAIL_NS::regex_cache_shard<charT, traits> shard_type;
+   typedef BOOST_REGEX_DETAIL_NS::regex_cache_entry<charT, traits> entry_type;
+public:
+   typedef basic_regex<charT, traits>               regex_type;
+   typedef typename regex_type::flag_type           flag_type;
+   typedef charT                                    value_type;
+   typedef traits                                   traits_type;
+   typedef std::size_t                              size_type;
+
+   //
+   // Holds at most max_size expressions using at most max_bytes between
+   // them, either of which may be zero for no limit:
+   //
+   explicit basic_regex_cache(size_type max_size = 256, size_type max_bytes = 0, size_type shards = BOOST_REGEX_DETAIL_NS::regex_cache_default_shards)
+      : m_clock(0)
+   {
+      if(max_size && (shards > max_size))
+         shards = max_size;
+      if(shards == 0)
+         shards = 1;
+      m_max_size = max_size ? (max_size + shards - 1) / shards : 0;
+      m_max_bytes = max_bytes ? (max_bytes + shards - 1) / shards : 0;
+      // each shard gets its own allocation so that they don't share cache lines:
+      for(size_type i = 0; i < shards; ++i)
+         m_shards.push_back(std::unique_ptr<shard_type>(new shard_type()));
+   }
+
+   //
+   // Each of these returns the compiled expression, which is shared with
+   // every other caller asking for the same one, and throws regex_error
+   // if it isn't valid:
+   //
+   std::shared_ptr<const regex_type> get(const charT* p1, const charT* p2, flag_type f = regex_constants::normal)
+   {
+      const std::size_t h = BOOST_REGEX_DETAIL_NS::regex_cache_hash(p1, p2, static_cast<unsigned>(f));
+      shard_type& shard = *m_shards[(h >> 8) % m_shards.size()];
+      std::shared_ptr<const regex_type> result = shard.find(p1, p2, f, h, m_clock.load(std::memory_order_relaxed));
+      if(result)
+         return result;
+      std::shared_ptr<entry_type> e(new entry_type());
+      e->pattern.assign(p1, p2);
+      e->flags = f;
+      e->hash = h;
+      e->regex.reset(new regex_type(p1, p2, f));
+      e->bytes = e->regex->memory_usage();
+      e->last_used.store(m_clock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return shard.insert(e, m_max_size, m_max_bytes);
+   }
+   std::shared_ptr<const regex_type> get(const charT* p, flag_type f = regex_constants::normal)
+   {
+      return get(p, p + traits::length(p), f);
+   }
+   template <class ST, class SA>
+   std::shared_ptr<const regex_type> get(const std::basic_string<charT, ST, SA>& p, flag_type f = regex_constants::normal)
+   {
+      return get(p.data(), p.data() + p.size(), f);
+   }
+
+   size_type size()const
+   {
+      size_type result = 0;
+      for(size_type i = 0; i < m_shards.size(); ++i)
+         result += m_shards[i]->size();
+      return result;
+   }
+   void clear()
+   {
+      for(size_type i = 0; i < m_shards.size(); ++i)
+         m_shards[i]->clear();
+   }
+   regex_cache_statistics statistics()const
+   {
+      regex_cache_statistics result = { 0, 0, 0, 0, 0 };
+      for(size_type i = 0; i < m_shards.size(); ++i)
+      {
+         result.hits += m_shards[i]->hits();
+         result.misses += m_shards[i]->misses();
+         result.evictions += m_shards[i]->evictions();
+         result.size += m_shards[i]->size();
+         result.bytes += m_shards[i]->bytes();
+      }
+      return result;
+   }
+
+private:
+   basic_regex_cache(const basic_regex_cache&);
+   basic_regex_cache& operator=(const basic_regex_cache&);
+
+   std::vector<std::unique_ptr<shard_type> > m_shards;
+   size_type                                 m_max_size;   // per shard
+   size_type                                 m_max_bytes;  // per shard
+   std::atomic<std::uint64_t>                m_clock;      // moves on with each miss
+};
+
+typedef basic_regex_cache<char> regex_cache;
+#ifndef BOOST_NO_WREGEX
+typedef basic_regex_cache<wchar_t> wregex_cache;
+#endif
+
+} // namespace boost
+
+#endif  // BOOST_REGEX_V5_REGEX_CACHE_HPP
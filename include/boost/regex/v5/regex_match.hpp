@@ -85,6 +85,65 @@ inline bool regex_match(const std::basic_string<charT, ST, SA>& s,
    return regex_match(s.begin(), s.end(), m, e, flags | regex_constants::match_any);
 }
 
+//
+// regex_match overloads which reuse the storage held by a regex_match_context
+// rather than allocating their own:
+//
+template <class BidiIterator, class Allocator, class charT, class traits>
+bool regex_match(BidiIterator first, BidiIterator last, 
+                 match_results<BidiIterator, Allocator>& m, 
+                 const basic_regex<charT, traits>& e, 
+                 regex_match_context<BidiIterator, Allocator>& context,
+                 match_flag_type flags = match_default)
+{
+   BOOST_REGEX_DETAIL_NS::perl_matcher<BidiIterator, Allocator, traits> matcher(first, last, m, e, flags, first, &context);
+   return matcher.match();
+}
+template <class iterator, class Allocator, class charT, class traits>
+bool regex_match(iterator first, iterator last, 
+                 const basic_regex<charT, traits>& e, 
+                 regex_match_context<iterator, Allocator>& context,
+                 match_flag_type flags = match_default)
+{
+   return regex_match(first, last, context.get_results(), e, context, flags | regex_constants::match_any);
+}
+template <class charT, class Allocator, class traits>
+inline bool regex_match(const charT* str, 
+                        match_results<const charT*, Allocator>& m, 
+                        const basic_regex<charT, traits>& e, 
+                        regex_match_context<const charT*, Allocator>& context,
+                        match_flag_type flags = match_default)
+{
+   return regex_match(str, str + traits::length(str), m, e, context, flags);
+}
+
+template <class ST, class SA, class Allocator, class charT, class traits>
+inline bool regex_match(const std::basic_string<charT, ST, SA>& s, 
+                 match_results<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& m, 
+                 const basic_regex<charT, traits>& e, 
+                 regex_match_context<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& context,
+                 match_flag_type flags = match_default)
+{
+   return regex_match(s.begin(), s.end(), m, e, context, flags);
+}
+template <class charT, class Allocator, class traits>
+inline bool regex_match(const charT* str, 
+                        const basic_regex<charT, traits>& e, 
+                        regex_match_context<const charT*, Allocator>& context,
+                        match_flag_type flags = match_default)
+{
+   return regex_match(str, str + traits::length(str), e, context, flags);
+}
+
+template <class ST, class SA, class Allocator, class charT, class traits>
+inline bool regex_match(const std::basic_string<charT, ST, SA>& s, 
+                 const basic_regex<charT, traits>& e, 
+                 regex_match_context<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& context,
+                 match_flag_type flags = match_default)
+{
+   return regex_match(s.begin(), s.end(), e, context, flags);
+}
+
 
 } // namespace boost
 
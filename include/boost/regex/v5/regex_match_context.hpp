@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         regex_match_context.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares template class regex_match_context, which
+  *                holds the working storage of regex_match and
+  *                regex_search between calls.
+  *                Note this is an internal header file included
+  *                by regex.hpp, do not include on its own.
+  */
+
+#ifndef BOOST_REGEX_V5_REGEX_MATCH_CONTEXT_HPP
+#define BOOST_REGEX_V5_REGEX_MATCH_CONTEXT_HPP
+
+namespace boost{
+
+/*** class regex_match_context ****************************************
+Storage that the matcher would otherwise have to allocate afresh on
+every call: the first block of the backtracking stack, the stack of
+recursions, the temporary results used by POSIX matching, and the
+results filled in by the overloads that only return true or false.
+Passing the same context to a series of calls lets each one reuse
+what the last one left behind.  A context may be used by only one
+thread at a time, but with any number of expressions.
+***********************************************************************/
+template <class BidiIterator, class Allocator>
+class regex_match_context
+{
+   typedef match_results<BidiIterator, Allocator> results_type;
+public:
+   regex_match_context() : m_block(0) {}
+   // copies share nothing, there's nothing worth copying:
+   regex_match_context(const regex_match_context&) : m_block(0) {}
+   regex_match_context& operator=(const regex_match_context&) { return *this; }
+   ~regex_match_context()
+   {
+      clear();
+   }
+   //
+   // Gives back everything held, leaving the context as new:
+   //
+   void clear()
+   {
+      if(m_block)
+         BOOST_REGEX_DETAIL_NS::put_mem_block(m_block);
+      m_block = 0;
+      std::vector<BOOST_REGEX_DETAIL_NS::recursion_info<results_type> >().swap(m_recursion_stack);
+      results_type().swap(m_temp_match);
+      results_type().swap(m_results);
+   }
+
+   //
+   // private interface, used by perl_matcher and regex_match/regex_search:
+   //
+   void*& get_stack_block()
+   {
+      return m_block;
+   }
+   std::vector<BOOST_REGEX_DETAIL_NS::recursion_info<results_type> >& get_recursion_stack()
+   {
+      return m_recursion_stack;
+   }
+   results_type& get_temp_match()
+   {
+      return m_temp_match;
+   }
+   results_type& get_results()
+   {
+      return m_results;
+   }
+
+private:
+   void*        m_block;        // first block of the backtracking stack, or null
+   std::vector<BOOST_REGEX_DETAIL_NS::recursion_info<results_type> > m_recursion_stack;
+   results_type m_temp_match;   // used in place of perl_matcher's POSIX temporary
+   results_type m_results;      // used by the overloads which have no match_results
+};
+
+} // namespace boost
+
+#endif  // BOOST_REGEX_V5_REGEX_MATCH_CONTEXT_HPP
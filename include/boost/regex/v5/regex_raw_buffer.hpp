@@ -156,12 +156,12 @@ public:
       return result;
    }
 
-   size_type  size()
+   size_type  size()const
    {
       return size_type(end - start);
    }
 
-   size_type  capacity()
+   size_type  capacity()const
    {
       return size_type(last - start);
    }
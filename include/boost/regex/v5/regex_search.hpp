@@ -96,6 +96,75 @@ inline bool regex_search(const std::basic_string<charT, ST, SA>& s,
    return regex_search(s.begin(), s.end(), e, flags);
 }
 
+//
+// regex_search overloads which reuse the storage held by a regex_match_context
+// rather than allocating their own:
+//
+template <class BidiIterator, class Allocator, class charT, class traits>
+bool regex_search(BidiIterator first, BidiIterator last, 
+                  match_results<BidiIterator, Allocator>& m, 
+                  const basic_regex<charT, traits>& e, 
+                  regex_match_context<BidiIterator, Allocator>& context,
+                  match_flag_type flags = match_default)
+{
+   if(e.flags() & regex_constants::failbit)
+      return false;
+
+   BOOST_REGEX_DETAIL_NS::perl_matcher<BidiIterator, Allocator, traits> matcher(first, last, m, e, flags, first, &context);
+   return matcher.find();
+}
+
+template <class BidiIterator, class Allocator, class charT, class traits>
+bool regex_search(BidiIterator first, BidiIterator last, 
+                  const basic_regex<charT, traits>& e, 
+                  regex_match_context<BidiIterator, Allocator>& context,
+                  match_flag_type flags = match_default)
+{
+   if(e.flags() & regex_constants::failbit)
+      return false;
+
+   BOOST_REGEX_DETAIL_NS::perl_matcher<BidiIterator, Allocator, traits> matcher(first, last, context.get_results(), e, flags | regex_constants::match_any, first, &context);
+   return matcher.find();
+}
+
+template <class charT, class Allocator, class traits>
+inline bool regex_search(const charT* str, 
+                        match_results<const charT*, Allocator>& m, 
+                        const basic_regex<charT, traits>& e, 
+                        regex_match_context<const charT*, Allocator>& context,
+                        match_flag_type flags = match_default)
+{
+   return regex_search(str, str + traits::length(str), m, e, context, flags);
+}
+
+template <class ST, class SA, class Allocator, class charT, class traits>
+inline bool regex_search(const std::basic_string<charT, ST, SA>& s, 
+                 match_results<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& m, 
+                 const basic_regex<charT, traits>& e, 
+                 regex_match_context<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& context,
+                 match_flag_type flags = match_default)
+{
+   return regex_search(s.begin(), s.end(), m, e, context, flags);
+}
+
+template <class charT, class Allocator, class traits>
+inline bool regex_search(const charT* str, 
+                        const basic_regex<charT, traits>& e, 
+                        regex_match_context<const charT*, Allocator>& context,
+                        match_flag_type flags = match_default)
+{
+   return regex_search(str, str + traits::length(str), e, context, flags);
+}
+
+template <class ST, class SA, class Allocator, class charT, class traits>
+inline bool regex_search(const std::basic_string<charT, ST, SA>& s, 
+                 const basic_regex<charT, traits>& e, 
+                 regex_match_context<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& context,
+                 match_flag_type flags = match_default)
+{
+   return regex_search(s.begin(), s.end(), e, context, flags);
+}
+
 } // namespace boost
 
 #endif  // BOOST_REGEX_V5_REGEX_SEARCH_HPP
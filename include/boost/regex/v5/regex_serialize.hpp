@@ -0,0 +1,460 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         regex_serialize.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Provides save_regex and load_regex, which write a
+  *                compiled expression out as a block of bytes, and
+  *                turn it back into a basic_regex without compiling.
+  *                Note this is an internal header file included
+  *                by regex.hpp, do not include on its own.
+  */
+
+#ifndef BOOST_REGEX_V5_REGEX_SERIALIZE_HPP
+#define BOOST_REGEX_V5_REGEX_SERIALIZE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace boost{
+
+namespace BOOST_REGEX_DETAIL_NS{
+
+//
+// Identifies a saved expression, and the byte order it was saved in:
+//
+static const std::uint32_t regex_blob_magic = 0x42524578u;  // "BREx"
+//
+// Must change whenever the states, or what regex_data holds, change:
+//
+static const std::uint32_t regex_blob_version = 5;
+
+/*** struct regex_blob_header *****************************************
+Starts every saved expression.  Besides the version, it records the
+sizes of the types that the saved states are made of, so that a blob
+written by a build which lays them out differently is refused rather
+than misread.  The checksum covers the payload_size bytes which follow
+the header.
+***********************************************************************/
+struct regex_blob_header
+{
+   std::uint32_t magic;
+   std::uint32_t version;
+   std::uint32_t char_size;      // sizeof(charT)
+   std::uint32_t class_size;     // sizeof(traits::char_class_type)
+   std::uint32_t pointer_size;   // sizeof(void*)
+   std::uint32_t repeat_size;    // sizeof(re_repeat)
+   std::uint32_t set_size;       // sizeof(re_set_long<char_class_type>)
+   std::uint32_t padding;        // alignment of the states
+   std::uint64_t payload_size;
+   std::uint64_t checksum;
+};
+
+template <class charT, class traits>
+void init_regex_blob_header(regex_blob_header& h)
+{
+   h.magic = regex_blob_magic;
+   h.version = regex_blob_version;
+   h.char_size = sizeof(charT);
+   h.class_size = sizeof(typename traits::char_class_type);
+   h.pointer_size = sizeof(void*);
+   h.repeat_size = sizeof(re_repeat);
+   h.set_size = sizeof(re_set_long<typename traits::char_class_type>);
+   h.padding = padding_size;
+   h.payload_size = 0;
+   h.checksum = 0;
+}
+
+//
+// A 64-bit checksum in the style of FNV-1a, but taking eight bytes at
+// a time into four independent lanes, so that it doesn't cost more
+// than the copy that loading does anyway:
+//
+inline std::uint64_t regex_blob_checksum(const unsigned char* p, std::size_t n)
+{
+   static const std::uint64_t prime = 0x100000001b3uLL;
+   std::uint64_t lanes[4] = { 0xcbf29ce484222325uLL, 0x84222325cbf29ce4uLL, 0x9e3779b97f4a7c15uLL, 0xc2b2ae3d27d4eb4fuLL };
+   std::size_t i = 0;
+   for(; n - i >= sizeof(lanes); i += sizeof(lanes))
+   {
+      for(unsigned j = 0; j < 4; ++j)
+      {
+         std::uint64_t w;
+         std::memcpy(&w, p + i + j * sizeof(w), sizeof(w));
+         lanes[j] = (lanes[j] ^ w) * prime;
+      }
+   }
+   for(; i < n; ++i)
+      lanes[0] = (lanes[0] ^ p[i]) * prime;
+   std::uint64_t h = n;
+   for(unsigned j = 0; j < 4; ++j)
+   {
+      h = (h ^ lanes[j] ^ (lanes[j] >> 29)) * prime;
+      h ^= h >> 32;
+   }
+   return h;
+}
+
+inline void raise_bad_regex_blob(const char* what)
+{
+   std::runtime_error err(what);
+   ::boost::BOOST_REGEX_DETAIL_NS::raise_runtime_error(err);
+}
+
+class regex_blob_writer
+{
+public:
+   explicit regex_blob_writer(std::vector<unsigned char>& v) : m_out(v) {}
+   void put_bytes(const void* p, std::size_t n)
+   {
+      const unsigned char* b = static_cast<const unsigned char*>(p);
+      m_out.insert(m_out.end(), b, b + n);
+   }
+   template <class T>
+   void put(const T& t)
+   {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be saved");
+      put_bytes(&t, sizeof(t));
+   }
+private:
+   std::vector<unsigned char>& m_out;
+};
+
+class regex_blob_reader
+{
+public:
+   regex_blob_reader(const unsigned char* p, std::size_t n) : m_position(p), m_end(p + n) {}
+   std::size_t remaining()const
+   {
+      return static_cast<std::size_t>(m_end - m_position);
+   }
+   const unsigned char* get_bytes(std::size_t n)
+   {
+      if(remaining() < n)
+         raise_bad_regex_blob("Saved regular expression is truncated.");
+      const unsigned char* result = m_position;
+      m_position += n;
+      return result;
+   }
+   void get_bytes(void* p, std::size_t n)
+   {
+      std::memcpy(p, get_bytes(n), n);
+   }
+   template <class T>
+   void get(T& t)
+   {
+      static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be loaded");
+      get_bytes(&t, sizeof(t));
+   }
+   std::size_t get_size()
+   {
+      std::uint64_t n;
+      get(n);
+      if(n > remaining())
+         raise_bad_regex_blob("Saved regular expression is corrupt.");
+      return static_cast<std::size_t>(n);
+   }
+private:
+   const unsigned char* m_position;
+   const unsigned char* m_end;
+};
+
+template <class charT>
+void save_literal(regex_blob_writer& w, const literal_search<charT>& l)
+{
+   w.put(static_cast<std::uint64_t>(l.size()));
+   w.put(static_cast<unsigned char>(l.icase()));
+   w.put(static_cast<unsigned char>(l.raw()));
+   w.put_bytes(l.begin(), l.size() * sizeof(charT));
+}
+
+template <class charT>
+void load_literal(regex_blob_reader& r, literal_search<charT>& l)
+{
+   std::size_t len = r.get_size();
+   unsigned char icase, raw;
+   r.get(icase);
+   r.get(raw);
+   if(len > r.remaining() / sizeof(charT))
+      raise_bad_regex_blob("Saved regular expression is corrupt.");
+   if(len == 0)
+   {
+      l.clear();
+      return;
+   }
+   std::vector<charT> s(len);
+   r.get_bytes(&s[0], len * sizeof(charT));
+   l.assign(&s[0], &s[0] + len, icase != 0, raw != 0);
+}
+
+//
+// Whether a state holds an alt offset_type as well as next:
+//
+inline bool state_has_alt(syntax_element_type t)
+{
+   switch(t)
+   {
+   case syntax_element_jump:
+   case syntax_element_alt:
+   case syntax_element_rep:
+   case syntax_element_dot_rep:
+   case syntax_element_char_rep:
+   case syntax_element_short_set_rep:
+   case syntax_element_long_set_rep:
+   case syntax_element_recurse:
+      return true;
+   default:
+      return false;
+   }
+}
+
+//
+// Copies the states starting at base into out, turning each next and
+// alt pointer back into an offset from the state that holds it, the
+// form they had before basic_regex_creator::fixup_pointers ran:
+//
+inline void save_states(const re_syntax_base* base, std::size_t size, unsigned char* out)
+{
+   std::memcpy(out, base, size);
+   const char* pbase = reinterpret_cast<const char*>(base);
+   for(const re_syntax_base* state = base; state; state = state->next.p)
+   {
+      const char* pstate = reinterpret_cast<const char*>(state);
+      std::ptrdiff_t i = state->next.p ? reinterpret_cast<const char*>(state->next.p) - pstate : 0;
+      std::memcpy(out + (reinterpret_cast<const char*>(&state->next) - pbase), &i, sizeof(i));
+      if(state_has_alt(state->type))
+      {
+         const offset_type& alt = static_cast<const re_jump*>(state)->alt;
+         i = reinterpret_cast<const char*>(alt.p) - pstate;
+         std::memcpy(out + (reinterpret_cast<const char*>(&alt) - pbase), &i, sizeof(i));
+      }
+   }
+}
+
+//
+// The reverse of save_states, applied in place to the size bytes of
+// states at base.  Every offset is checked to land on a state inside
+// the buffer, and next offsets must move forward, which they always
+// do in a compiled expression, so that a damaged blob can't send us
+// off into the weeds:
+//
+inline void load_states(re_syntax_base* base, std::size_t size)
+{
+   char* pbase = reinterpret_cast<char*>(base);
+   std::size_t position = 0;
+   for(;;)
+   {
+      if((position & padding_mask) || (size < sizeof(re_syntax_base)) || (position > size - sizeof(re_syntax_base)))
+         raise_bad_regex_blob("Saved regular expression is corrupt.");
+      re_syntax_base* state = reinterpret_cast<re_syntax_base*>(pbase + position);
+      if(static_cast<unsigned>(state->type) > static_cast<unsigned>(syntax_element_then))
+         raise_bad_regex_blob("Saved regular expression is corrupt.");
+      if(state_has_alt(state->type))
+      {
+         if(position > size - sizeof(re_jump))
+            raise_bad_regex_blob("Saved regular expression is corrupt.");
+         offset_type& alt = static_cast<re_jump*>(state)->alt;
+         std::ptrdiff_t target = static_cast<std::ptrdiff_t>(position) + alt.i;
+         if((target < 0) || (static_cast<std::size_t>(target) > size - sizeof(re_syntax_base)) || (target & padding_mask))
+            raise_bad_regex_blob("Saved regular expression is corrupt.");
+         alt.p = reinterpret_cast<re_syntax_base*>(pbase + target);
+         if((state->type != syntax_element_jump) && (state->type != syntax_element_alt) && (state->type != syntax_element_recurse))
+         {
+            // single character repeats may point forward to the literal after them:
+            if(size - position < sizeof(re_repeat))
+               raise_bad_regex_blob("Saved regular expression is corrupt.");
+            std::ptrdiff_t literal = static_cast<re_repeat*>(state)->following_literal;
+            if(literal && ((state->type == syntax_element_rep) || (literal < 0) || (literal & padding_mask)
+               || (static_cast<std::size_t>(literal) > size - position - sizeof(re_literal))
+               || (reinterpret_cast<re_syntax_base*>(pbase + position + literal)->type != syntax_element_literal)))
+               raise_bad_regex_blob("Saved regular expression is corrupt.");
+         }
+      }
+      std::ptrdiff_t i = state->next.i;
+      if(i == 0)
+      {
+         state->next.p = 0;
+         break;
+      }
+      if((i < 0) || (static_cast<std::size_t>(i) > size - position))
+         raise_bad_regex_blob("Saved regular expression is corrupt.");
+      position += static_cast<std::size_t>(i);
+      state->next.p = reinterpret_cast<re_syntax_base*>(pbase + position);
+   }
+}
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
+//
+// Appends the compiled form of e to blob.  A blob can only be loaded
+// by a program built from the same version of this library, with the
+// same compiler settings, and using the same traits class and locale
+// as the program which saved it.  Any number of blobs may be stored
+// one after another.
+//
+template <class charT, class traits>
+void save_regex(const basic_regex<charT, traits>& e, std::vector<unsigned char>& blob)
+{
+   typedef typename traits::char_class_type char_class_type;
+   if(e.status())
+      boost::throw_exception(std::logic_error("Can't save an invalid regex."));
+   const BOOST_REGEX_DETAIL_NS::regex_data<charT, traits>& data = e.get_data();
+
+   std::size_t start = blob.size();
+   BOOST_REGEX_DETAIL_NS::regex_blob_header header;
+   BOOST_REGEX_DETAIL_NS::init_regex_blob_header<charT, traits>(header);
+   BOOST_REGEX_DETAIL_NS::regex_blob_writer w(blob);
+   w.put(header);
+
+   std::size_t states_size = reinterpret_cast<const char*>(data.m_expression) - static_cast<const char*>(data.m_data.data());
+   w.put(static_cast<std::uint64_t>(data.m_data.size()));
+   w.put(static_cast<std::uint64_t>(states_size));
+   w.put(static_cast<std::uint64_t>(data.m_expression_len));
+   w.put(data.m_flags);
+   w.put(static_cast<std::uint64_t>(data.m_mark_count));
+   w.put(data.m_restart_type);
+   w.put(data.m_startmap);
+   w.put(data.m_can_be_null);
+   w.put<char_class_type>(data.m_word_mask);
+   w.put(static_cast<unsigned char>(data.m_has_recursions));
+   w.put(static_cast<unsigned char>(data.m_disable_match_any));
+   w.put(static_cast<std::uint64_t>(data.m_required_offset));
+   w.put(static_cast<unsigned char>(data.m_raw_chars));
+   w.put(static_cast<std::uint64_t>(data.m_subs.size()));
+   for(std::size_t i = 0; i < data.m_subs.size(); ++i)
+   {
+      w.put(static_cast<std::uint64_t>(data.m_subs[i].first));
+      w.put(static_cast<std::uint64_t>(data.m_subs[i].second));
+   }
+   const std::vector<BOOST_REGEX_DETAIL_NS::named_subexpressions::name>& names = data.get_names();
+   w.put(static_cast<std::uint64_t>(names.size()));
+   for(std::size_t i = 0; i < names.size(); ++i)
+   {
+      w.put(names[i].index);
+      w.put(names[i].hash);
+   }
+   BOOST_REGEX_DETAIL_NS::save_literal(w, data.m_prefix);
+   BOOST_REGEX_DETAIL_NS::save_literal(w, data.m_required);
+
+   std::size_t states_start = blob.size();
+   blob.resize(states_start + data.m_data.size());
+   BOOST_REGEX_DETAIL_NS::save_states(data.m_first_state, data.m_data.size(), &blob[states_start]);
+
+   header.payload_size = blob.size() - start - sizeof(header);
+   header.checksum = BOOST_REGEX_DETAIL_NS::regex_blob_checksum(&blob[start + sizeof(header)], static_cast<std::size_t>(header.payload_size));
+   std::memcpy(&blob[start], &header, sizeof(header));
+}
+
+//
+// Replaces e with the expression saved at [p, p + n), which may be
+// followed by more blobs, and returns the number of bytes used.
+// Throws std::runtime_error, leaving e unchanged, if the data isn't a
+// saved expression that this program can use.  The checksum only
+// guards against damage: only load blobs from a source you trust.
+//
+template <class charT, class traits>
+std::size_t load_regex(basic_regex<charT, traits>& e, const void* p, std::size_t n)
+{
+   typedef BOOST_REGEX_DETAIL_NS::basic_regex_implementation<charT, traits> impl_type;
+   typedef typename traits::char_class_type char_class_type;
+
+   BOOST_REGEX_DETAIL_NS::regex_blob_reader header_reader(static_cast<const unsigned char*>(p), n);
+   BOOST_REGEX_DETAIL_NS::regex_blob_header header, expected;
+   header_reader.get(header);
+   BOOST_REGEX_DETAIL_NS::init_regex_blob_header<charT, traits>(expected);
+   if(header.magic != expected.magic)
+      BOOST_REGEX_DETAIL_NS::raise_bad_regex_blob("Not a saved regular expression, or saved with a different byte order.");
+   if(header.version != expected.version)
+      BOOST_REGEX_DETAIL_NS::raise_bad_regex_blob("Saved regular expression has the wrong format version.");
+   if((header.char_size != expected.char_size) || (header.class_size != expected.class_size)
+      || (header.pointer_size != expected.pointer_size) || (header.repeat_size != expected.repeat_size)
+      || (header.set_size != expected.set_size) || (header.padding != expected.padding))
+      BOOST_REGEX_DETAIL_NS::raise_bad_regex_blob("Saved regular expression was written by an incompatible build.");
+   if(header.payload_size > header_reader.remaining())
+      BOOST_REGEX_DETAIL_NS::raise_bad_regex_blob("Saved regular expression is truncated.");
+   std::size_t payload_size = static_cast<std::size_t>(header.payload_size);
+   const unsigned char* payload = header_reader.get_bytes(payload_size);
+   if(BOOST_REGEX_DETAIL_NS::regex_blob_checksum(payload, payload_size) != header.checksum)
+      BOOST_REGEX_DETAIL_NS::raise_bad_regex_blob("Saved regular expression is corrupt.");
+
+   // share the traits object, and so the locale, of the current expression:
+   std::shared_ptr<impl_type> temp;
+   if(e.get_implementation().get())
+      temp.reset(new impl_type(e.get_implementation()->m_ptraits));
+   else
+      temp.reset(new impl_type());
+
+   BOOST_REGEX_DETAIL_NS::regex_blob_reader r(payload, payload_size);
+   std::uint64_t data_size, states_size, expression_len, mark_count, required_offset;
+   unsigned char has_recursions, disable_match_any, raw_chars;
+   r.get(data_size);
+   r.get(states_size);
+   r.get(expression_len);
+   r.get(temp->m_flags);
+   r.get(mark_count);
+   r.get(temp->m_restart_type);
+   r.get(temp->m_startmap);
+   r.get(temp->m_can_be_null);
+   r.get<char_class_type>(temp->m_word_mask);
+   r.get(has_recursions);
+   r.get(disable_match_any);
+   r.get(required_offset);
+   r.get(raw_chars);
+   temp->m_mark_count = static_cast<std::size_t>(mark_count);
+   temp->m_has_recursions = has_recursions != 0;
+   temp->m_disable_match_any = disable_match_any != 0;
+   temp->m_required_offset = static_cast<std::size_t>(required_offset);
+   temp->m_raw_chars = raw_chars != 0;
+   std::size_t count = r.get_size();
+   temp->m_subs.resize(count);
+   for(std::size_t i = 0; i < count; ++i)
+   {
+      std::uint64_t first, second;
+      r.get(first);
+      r.get(second);
+      temp->m_subs[i] = std::pair<std::size_t, std::size_t>(static_cast<std::size_t>(first), static_cast<std::size_t>(second));
+   }
+   count = r.get_size();
+   std::vector<BOOST_REGEX_DETAIL_NS::named_subexpressions::name>& names = temp->get_names();
+   for(std::size_t i = 0; i < count; ++i)
+   {
+      int index, hash;
+      r.get(index);
+      r.get(hash);
+      names.push_back(BOOST_REGEX_DETAIL_NS::named_subexpressions::name(hash, index));
+   }
+   BOOST_REGEX_DETAIL_NS::load_literal(r, temp->m_prefix);
+   BOOST_REGEX_DETAIL_NS::load_literal(r, temp->m_required);
+
+   // the states, followed by the null-terminated expression:
+   if((data_size != r.remaining()) || (states_size > data_size)
+      || ((data_size - states_size) / sizeof(charT) <= expression_len))
+      BOOST_REGEX_DETAIL_NS::raise_bad_regex_blob("Saved regular expression is corrupt.");
+   void* states = temp->m_data.extend(static_cast<std::size_t>(data_size));
+   r.get_bytes(states, static_cast<std::size_t>(data_size));
+   temp->m_first_state = static_cast<BOOST_REGEX_DETAIL_NS::re_syntax_base*>(states);
+   BOOST_REGEX_DETAIL_NS::load_states(temp->m_first_state, static_cast<std::size_t>(states_size));
+   temp->m_expression = reinterpret_cast<const charT*>(static_cast<const char*>(states) + states_size);
+   temp->m_expression_len = static_cast<std::ptrdiff_t>(expression_len);
+   temp->m_startmap_search.assign(temp->m_startmap, static_cast<unsigned char>(BOOST_REGEX_DETAIL_NS::mask_any));
+   temp->m_status = 0;
+
+   e.set_implementation(temp);
+   return sizeof(header) + payload_size;
+}
+
+} // namespace boost
+
+#endif  // BOOST_REGEX_V5_REGEX_SERIALIZE_HPP
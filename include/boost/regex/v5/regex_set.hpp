@@ -0,0 +1,789 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         regex_set.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares template class basic_regex_set, and the
+  *                regex_search overloads which find which of its
+  *                expressions match in a single pass over the input.
+  *                Note this is an internal header file included
+  *                by regex.hpp, do not include on its own.
+  */
+
+#ifndef BOOST_REGEX_V5_REGEX_SET_HPP
+#define BOOST_REGEX_V5_REGEX_SET_HPP
+
+namespace boost{
+
+namespace BOOST_REGEX_DETAIL_NS{
+
+//
+// The start node of an expression which has no program:
+//
+static const unsigned regex_set_no_program = ~0u;
+
+/*** class regex_set_program ******************************************
+The dfa_program's of all the expressions in a set, merged into one:
+the nodes of each are copied in turn, with each dfa_match node's arg
+recording which expression it belongs to, identical sets and branch
+rows are shared, and the character classes are refined so that they
+tell apart every pair of characters that any one of the programs
+does.  The start maps of the expressions are merged into a table of
+the expressions that can start with each character.
+***********************************************************************/
+class regex_set_program
+{
+public:
+   regex_set_program() : m_program_count(0) {}
+
+   //
+   // Adds the next expression, which has program p (which may be null
+   // if the expression can't be converted), and start map map:
+   //
+   void add(const dfa_program* p, const unsigned char* map, bool can_be_null)
+   {
+      const unsigned member = static_cast<unsigned>(m_starts.size());
+      if(p == 0)
+      {
+         m_starts.push_back(regex_set_no_program);
+         m_skips.push_back(0);
+         return;
+      }
+      const unsigned offset = static_cast<unsigned>(m_program.m_nodes.size());
+      std::vector<int> set_ids(p->m_sets.size() >> CHAR_BIT);
+      for(std::size_t s = 0; s < set_ids.size(); ++s)
+      {
+         std::string members(p->m_sets.begin() + (s << CHAR_BIT), p->m_sets.begin() + ((s + 1) << CHAR_BIT));
+         std::map<std::string, int>::const_iterator i = m_set_ids.find(members);
+         if(i == m_set_ids.end())
+         {
+            i = m_set_ids.insert(std::make_pair(members, static_cast<int>(m_set_ids.size()))).first;
+            m_program.m_sets.insert(m_program.m_sets.end(), members.begin(), members.end());
+         }
+         set_ids[s] = i->second;
+      }
+      std::vector<int> branch_ids(p->m_branches.size() / dfa_branch_size);
+      for(std::size_t b = 0; b < branch_ids.size(); ++b)
+      {
+         std::string row(p->m_branches.begin() + b * dfa_branch_size, p->m_branches.begin() + (b + 1) * dfa_branch_size);
+         std::map<std::string, int>::const_iterator i = m_branch_ids.find(row);
+         if(i == m_branch_ids.end())
+         {
+            i = m_branch_ids.insert(std::make_pair(row, static_cast<int>(m_branch_ids.size()))).first;
+            m_program.m_branches.insert(m_program.m_branches.end(), row.begin(), row.end());
+         }
+         branch_ids[b] = i->second;
+      }
+      for(std::size_t i = 0; i < p->m_nodes.size(); ++i)
+      {
+         dfa_node n = p->m_nodes[i];
+         n.next += offset;
+         n.alt += offset;
+         if(n.type == dfa_char)
+            n.arg = set_ids[n.arg];
+         else if((n.type == dfa_split) && (n.arg >= 0))
+            n.arg = branch_ids[n.arg];
+         else if(n.type == dfa_match)
+            n.arg = static_cast<int>(member);
+         m_program.m_nodes.push_back(n);
+      }
+      m_owners.resize(m_program.m_nodes.size(), member);
+      m_program.m_repeat_count = (std::max)(m_program.m_repeat_count, p->m_repeat_count);
+      m_program.m_has_asserts = m_program.m_has_asserts || p->m_has_asserts;
+      refine_classes(*p);
+
+      m_starts.push_back(p->m_start + offset);
+      m_skips.push_back((p->skips_starts(regex_constants::match_default) ? skips_always : 0) | (p->skips_starts(regex_constants::match_any) ? skips_with_any : 0));
+      if(can_be_null)
+         m_nulls.push_back(member);
+      else
+      {
+         for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+         {
+            if(map[c] & mask_any)
+               m_first[c].push_back(member);
+         }
+      }
+      ++m_program_count;
+   }
+
+   const dfa_program& program()const { return m_program; }
+   // the number of expressions which have a program:
+   std::size_t program_count()const { return m_program_count; }
+   // the start node of each expression, or regex_set_no_program:
+   const std::vector<unsigned>& starts()const { return m_starts; }
+   // the expression each node belongs to:
+   const std::vector<unsigned>& owners()const { return m_owners; }
+   // the expressions which can start with character c:
+   const std::vector<unsigned>& first(unsigned char c)const { return m_first[c]; }
+   // the expressions which can match a null string, and so can start anywhere:
+   const std::vector<unsigned>& nulls()const { return m_nulls; }
+   // whether perl_matcher may skip starts of expression i that could match, see dfa_program::skips_starts:
+   bool skips_starts(std::size_t i, match_flag_type f)const
+   {
+      return (m_skips[i] & ((f & regex_constants::match_any) ? skips_with_any : skips_always)) != 0;
+   }
+
+private:
+   enum skip_type
+   {
+      skips_always = 1,
+      skips_with_any = 2
+   };
+
+   void refine_classes(const dfa_program& p)
+   {
+      std::map<std::pair<unsigned, unsigned>, unsigned> classes;
+      m_program.m_class_chars.clear();
+      m_program.m_class_props.clear();
+      for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+      {
+         std::pair<unsigned, unsigned> signature(m_program.m_classes[c], p.m_classes[c]);
+         std::map<std::pair<unsigned, unsigned>, unsigned>::const_iterator i = classes.find(signature);
+         if(i == classes.end())
+         {
+            i = classes.insert(std::make_pair(signature, static_cast<unsigned>(classes.size()))).first;
+            m_program.m_class_chars.push_back(static_cast<unsigned char>(c));
+            m_program.m_class_props.push_back(p.m_class_props[p.m_classes[c]]);
+         }
+         m_program.m_classes[c] = static_cast<unsigned char>(i->second);
+      }
+      m_program.m_class_count = static_cast<unsigned>(classes.size());
+   }
+
+   dfa_program                m_program;
+   std::size_t                m_program_count;
+   std::vector<unsigned>      m_starts;
+   std::vector<unsigned char> m_skips;     // the skip_type's of each expression
+   std::vector<unsigned>      m_owners;
+   std::vector<unsigned>      m_first[1 << CHAR_BIT];
+   std::vector<unsigned>      m_nulls;
+   std::map<std::string, int> m_set_ids;   // index of each distinct set
+   std::map<std::string, int> m_branch_ids; // index of each distinct branch row
+};
+
+/*** class regex_set_dfa **********************************************
+Runs a regex_set_program over the input in a single pass, as a lazy
+DFA much like dfa_cache, except that we want to know every expression
+that matches rather than where the first match is: so nothing is
+given priority over anything else, and each transition records which
+of the expressions have a match ending just before its character.
+New threads are started only for the expressions whose start maps
+allow some character of the next character's class, and whenever
+nothing is running we skip straight to the next character that any
+of them can start with.  Branches go only the ways that the program's
+branch rows allow, as in pike_vm.
+***********************************************************************/
+class regex_set_dfa
+{
+public:
+   regex_set_dfa() : m_program(0), m_flags(regex_constants::match_default), m_anchored(false),
+      m_stride(0), m_remaining(0), m_generation(0), m_entered(0), m_flushed(false), m_flush_position(0) {}
+
+   void init(const regex_set_program* p)
+   {
+      if(p == m_program)
+         return;
+      const dfa_program& program = p->program();
+      m_program = p;
+      m_stride = program.m_class_count + 1;
+      m_marks.assign(program.m_nodes.size(), 0);
+      m_visits.resize(program.m_nodes.size());
+      m_candidates.assign(program.m_class_count, std::vector<unsigned>());
+      std::vector<unsigned> added(p->starts().size(), ~0u);
+      for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+      {
+         const unsigned cls = program.m_classes[c];
+         const std::vector<unsigned>& first = p->first(static_cast<unsigned char>(c));
+         for(std::size_t i = 0; i < first.size(); ++i)
+         {
+            if(added[first[i]] != cls)
+            {
+               added[first[i]] = cls;
+               m_candidates[cls].push_back(first[i]);
+            }
+         }
+         m_can_start[c] = !first.empty() || !p->nulls().empty();
+      }
+      clear();
+   }
+   //
+   // Records in found() which expressions match somewhere in
+   // [first, last), returns false if we've given up:
+   //
+   template <class BidiIterator>
+   bool find(BidiIterator first, BidiIterator last, match_flag_type f)
+   {
+      // \A and ^ would disagree about where the start is:
+      if((f & regex_constants::match_prev_avail) && m_program->program().m_has_asserts)
+         return false;
+      set_flags(f);
+      const unsigned char* classes = m_program->program().m_classes;
+      const unsigned edge = m_program->program().m_class_count;
+      m_found.assign(m_program->starts().size(), 0);
+      m_remaining = m_program->program_count();
+      std::size_t count = 0;
+      int state = start(edge);
+      const int* table = &m_table[0];
+      while(first != last)
+      {
+         if(m_idle[state / m_stride] && !m_anchored && !m_can_start[static_cast<unsigned char>(*first)])
+         {
+            // nothing in progress: skip anything that can't start a match:
+            unsigned char c;
+            do
+            {
+               c = static_cast<unsigned char>(*first);
+               ++first;
+               ++count;
+            }while((first != last) && !m_can_start[static_cast<unsigned char>(*first)]);
+            state = start(classes[c]);
+            table = &m_table[0];
+            if(first == last)
+               break;
+         }
+         unsigned cls = classes[static_cast<unsigned char>(*first)];
+         int t = table[state + cls];
+         int hits = t < 0 ? -1 : m_hits[state + cls];
+         if(t < 0)
+         {
+            t = compute(state, cls, count, hits);
+            if(t < 0)
+               return false;
+            table = &m_table[0];
+         }
+         if((t & 1) && record(hits))
+            return true;
+         state = t >> 1;
+         ++first;
+         ++count;
+         if(m_dead[state / m_stride])
+            return true;
+      }
+      int t = table[state + edge];
+      int hits = t < 0 ? -1 : m_hits[state + edge];
+      if(t < 0)
+         t = compute(state, edge, count, hits);
+      if(t < 0)
+         return false;
+      if(t & 1)
+         record(hits);
+      return true;
+   }
+   //
+   // Whether expression i was found to match:
+   //
+   bool found(std::size_t i)const
+   {
+      return m_found[i] != 0;
+   }
+
+private:
+   void clear()
+   {
+      m_index.clear();
+      m_keys.clear();
+      m_table.clear();
+      m_hits.clear();
+      m_hit_lists.clear();
+      m_dead.clear();
+      m_idle.clear();
+   }
+   //
+   // Which flags we're using changes what the states do, so we
+   // have to start again if they change:
+   //
+   void set_flags(match_flag_type f)
+   {
+      const match_flag_type used = regex_constants::match_not_bol | regex_constants::match_not_eol
+         | regex_constants::match_not_bob | regex_constants::match_not_eob | regex_constants::match_not_bow
+         | regex_constants::match_not_eow | regex_constants::match_not_dot_newline
+         | regex_constants::match_not_dot_null | regex_constants::match_single_line
+         | regex_constants::match_continuous | regex_constants::match_any;
+      f &= used;
+      if(f != m_flags)
+      {
+         m_flags = f;
+         m_anchored = (f & regex_constants::match_continuous) != 0;
+         clear();
+      }
+      m_flushed = false;
+   }
+   //
+   // Marks the expressions in m_hit_lists[i] as found, returns true if
+   // there's nothing left to find:
+   //
+   bool record(int i)
+   {
+      const std::vector<unsigned>& hits = m_hit_lists[i];
+      for(std::size_t j = 0; j < hits.size(); ++j)
+      {
+         if(!m_found[hits[j]])
+         {
+            m_found[hits[j]] = 1;
+            --m_remaining;
+         }
+      }
+      return m_remaining == 0;
+   }
+   //
+   // The row of the state we start in, given the class of the character
+   // before the starting point; each state's key is that class, whether
+   // new threads may start, and the nodes still running:
+   //
+   int start(unsigned ctx)
+   {
+      if(m_keys.size() >= BOOST_REGEX_DFA_MAX_STATES)
+         clear();
+      std::vector<unsigned> key;
+      key.push_back(m_program->program().m_has_asserts ? ctx : 0);
+      key.push_back(1);
+      std::map<std::vector<unsigned>, int>::const_iterator i = m_index.find(key);
+      return (i == m_index.end() ? add_state(key) : i->second) * static_cast<int>(m_stride);
+   }
+   //
+   // Works out a transition, which is (offset of the next state's row << 1)
+   // | (1 if a match of anything ends before this character), or returns
+   // -1 if we've given up; hits is set to the index in m_hit_lists of the
+   // expressions matched, and "position" is how far into this search we are:
+   //
+   int compute(int row, unsigned cls, std::size_t position, int& hits)
+   {
+      const dfa_program& program = m_program->program();
+      const std::vector<unsigned>& key = *m_keys[row / m_stride];
+      const unsigned before = key[0];
+      const unsigned after = cls;
+      m_visits.clear();
+      m_list.clear();
+      m_found_here.clear();
+      for(std::size_t i = 2; i < key.size(); ++i)
+         closure(key[i], before, after);
+      if(key[1])
+      {
+         const std::vector<unsigned>& starts = m_program->starts();
+         const std::vector<unsigned>& nulls = m_program->nulls();
+         for(std::size_t i = 0; i < nulls.size(); ++i)
+            closure(starts[nulls[i]], before, after);
+         if(cls != program.m_class_count)
+         {
+            for(std::size_t i = 0; i < m_candidates[cls].size(); ++i)
+               closure(starts[m_candidates[cls][i]], before, after);
+         }
+      }
+      // paths were lost, so the expressions they'd have matched may be missing:
+      if(m_visits.overflowed())
+         return -1;
+      int hit = 0;
+      hits = -1;
+      if(!m_found_here.empty())
+      {
+         std::sort(m_found_here.begin(), m_found_here.end());
+         m_found_here.erase(std::unique(m_found_here.begin(), m_found_here.end()), m_found_here.end());
+         hits = m_hits[row + cls] = static_cast<int>(m_hit_lists.size());
+         m_hit_lists.push_back(m_found_here);
+         hit = 1;
+      }
+      if(cls == program.m_class_count)
+         return m_table[row + cls] = hit;
+      next_generation();
+      m_kernel.clear();
+      m_kernel.push_back(program.m_has_asserts ? cls : 0);
+      m_kernel.push_back(m_anchored ? 0 : 1);
+      for(std::size_t i = 0; i < m_list.size(); ++i)
+      {
+         const dfa_node& n = program.m_nodes[m_list[i]];
+         if(program.accepts(n, cls, m_flags) && (m_marks[n.next] != m_generation))
+         {
+            m_marks[n.next] = m_generation;
+            m_kernel.push_back(n.next);
+         }
+      }
+      // priorities don't matter, so any order will do:
+      std::sort(m_kernel.begin() + 2, m_kernel.end());
+      std::map<std::vector<unsigned>, int>::const_iterator pos = m_index.find(m_kernel);
+      if(pos != m_index.end())
+         return m_table[row + cls] = ((pos->second * static_cast<int>(m_stride)) << 1) | hit;
+      if(m_keys.size() >= BOOST_REGEX_DFA_MAX_STATES)
+      {
+         // out of room: start again, but give up if we last did so only a little while ago:
+         if(m_flushed && (position - m_flush_position < 10 * static_cast<std::size_t>(BOOST_REGEX_DFA_MAX_STATES)))
+            return -1;
+         m_flushed = true;
+         m_flush_position = position;
+         clear();
+         if(hit)
+         {
+            hits = 0;
+            m_hit_lists.push_back(m_found_here);
+         }
+         return ((add_state(m_kernel) * static_cast<int>(m_stride)) << 1) | hit;
+      }
+      int target = add_state(m_kernel);
+      return m_table[row + cls] = ((target * static_cast<int>(m_stride)) << 1) | hit;
+   }
+   int add_state(const std::vector<unsigned>& key)
+   {
+      int id = static_cast<int>(m_keys.size());
+      std::map<std::vector<unsigned>, int>::iterator i = m_index.insert(std::make_pair(key, id)).first;
+      m_keys.push_back(&i->first);
+      m_table.insert(m_table.end(), m_stride, -1);
+      m_hits.insert(m_hits.end(), m_stride, -1);
+      m_dead.push_back((key.size() == 2) && !key[1] ? 1 : 0);
+      m_idle.push_back((key.size() == 2) && key[1] ? 1 : 0);
+      return id;
+   }
+   //
+   // Adds the nodes reachable from node i that are waiting on a
+   // character to m_list, and the expressions whose matches we reach
+   // to m_found_here, handling repeats as dfa_cache::closure does:
+   //
+   void closure(unsigned i, unsigned before, unsigned after)
+   {
+      const dfa_program& program = m_program->program();
+      const unsigned count = static_cast<unsigned>(program.m_nodes.size());
+      m_stack.push_back(i);
+      while(!m_stack.empty())
+      {
+         i = m_stack.back();
+         m_stack.pop_back();
+         if(i >= count)
+         {
+            m_entered &= ~dfa_visits::repeat_bit(static_cast<int>(i - count));
+            continue;
+         }
+         const dfa_node& n = program.m_nodes[i];
+         if(!m_visits.visit(i, (n.type == dfa_char) || (n.type == dfa_dot) || (n.type == dfa_match) ? 0 : m_entered))
+            continue;
+         switch(n.type)
+         {
+         case dfa_char:
+         case dfa_dot:
+            m_list.push_back(i);
+            break;
+         case dfa_split:
+         {
+            const unsigned ways = program.ways(n, after, m_flags);
+            if(ways & dfa_way_alt)
+               m_stack.push_back(n.alt);
+            if(ways & dfa_way_next)
+               m_stack.push_back(n.next);
+            break;
+         }
+         case dfa_epsilon:
+            m_stack.push_back(n.next);
+            break;
+         case dfa_assert:
+            if(program.check(n.arg, before, after, m_flags))
+               m_stack.push_back(n.next);
+            break;
+         case dfa_repeat:
+            if((m_entered & dfa_visits::repeat_bit(n.arg)) == 0)
+            {
+               m_entered |= dfa_visits::repeat_bit(n.arg);
+               m_stack.push_back(count + n.arg);
+            }
+            m_stack.push_back(n.next);
+            break;
+         case dfa_loop:
+            m_stack.push_back(m_entered & dfa_visits::repeat_bit(n.arg) ? n.alt : n.next);
+            break;
+         case dfa_match:
+            m_found_here.push_back(static_cast<unsigned>(n.arg));
+            break;
+         default:
+            break;
+         }
+      }
+   }
+   void next_generation()
+   {
+      if(++m_generation == 0)
+      {
+         std::fill(m_marks.begin(), m_marks.end(), 0u);
+         m_generation = 1;
+      }
+   }
+
+   regex_set_dfa(const regex_set_dfa&);
+   regex_set_dfa& operator=(const regex_set_dfa&);
+
+   const regex_set_program*               m_program;
+   match_flag_type                        m_flags;          // the flags the states were built for
+   bool                                   m_anchored;       // whether matches may only start at the start
+   unsigned                               m_stride;         // entries per state in m_table
+   std::vector<std::vector<unsigned> >    m_candidates;     // expressions that may start with each class
+   bool                                   m_can_start[1 << CHAR_BIT]; // whether anything may start with each character
+   std::map<std::vector<unsigned>, int>   m_index;          // state for each key
+   std::vector<const std::vector<unsigned>*> m_keys;        // key of each state
+   std::vector<int>                       m_table;          // transitions, or -1 if not yet known
+   std::vector<int>                       m_hits;           // index in m_hit_lists of each transition's matches
+   std::vector<std::vector<unsigned> >    m_hit_lists;      // the expressions matched by transitions
+   std::vector<unsigned char>             m_dead;           // whether each state can never match
+   std::vector<unsigned char>             m_idle;           // whether each state has nothing in progress
+   std::vector<unsigned char>             m_found;          // whether each expression has been found
+   std::size_t                            m_remaining;      // number of expressions not yet found
+   std::vector<unsigned>                  m_marks;          // visited marks for each node
+   unsigned                               m_generation;     // current value of m_marks
+   std::vector<unsigned>                  m_stack;          // scratch space
+   dfa_visits                             m_visits;         // nodes visited by closure()
+   std::uint64_t                          m_entered;        // repeats started on the current path of closure()
+   std::vector<unsigned>                  m_list;           // scratch space
+   std::vector<unsigned>                  m_kernel;         // scratch space
+   std::vector<unsigned>                  m_found_here;     // scratch space
+   bool                                   m_flushed;        // whether we've thrown the cache away during this search
+   std::size_t                            m_flush_position; // how far into the search that was
+};
+
+//
+// Returns the program of narrow character expression e, if it has one:
+//
+template <class charT, class traits>
+inline const dfa_program* get_set_member_program(const basic_regex<charT, traits>& e, _narrow_type*)
+{
+   return e.get_data().m_dfa.program(e.get_data());
+}
+template <class charT, class traits>
+inline const dfa_program* get_set_member_program(const basic_regex<charT, traits>&, _wide_type*)
+{
+   return 0;
+}
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
+/*** class basic_regex_set ********************************************
+A collection of expressions that are searched for all at once: each
+expression is identified by the order in which it was added, starting
+from zero.
+***********************************************************************/
+template <class charT, class traits = regex_traits<charT> >
+class basic_regex_set
+{
+   typedef BOOST_REGEX_DETAIL_NS::machine_pool<BOOST_REGEX_DETAIL_NS::regex_set_dfa> pool_type;
+public:
+   typedef basic_regex<charT, traits>               regex_type;
+   typedef typename regex_type::flag_type           flag_type;
+   typedef charT                                    value_type;
+   typedef traits                                   traits_type;
+   typedef std::size_t                              size_type;
+
+   basic_regex_set()
+      : m_program(new BOOST_REGEX_DETAIL_NS::regex_set_program()), m_dfas(new pool_type()) {}
+
+   //
+   // Each of these returns the id of the expression added, and
+   // throws regex_error if it isn't valid:
+   //
+   size_type add(const charT* p, flag_type f = regex_constants::normal)
+   {
+      return add(regex_type(p, f));
+   }
+   size_type add(const charT* p1, const charT* p2, flag_type f = regex_constants::normal)
+   {
+      return add(regex_type(p1, p2, f));
+   }
+   template <class ST, class SA>
+   size_type add(const std::basic_string<charT, ST, SA>& p, flag_type f = regex_constants::normal)
+   {
+      return add(regex_type(p, f));
+   }
+   size_type add(const regex_type& e)
+   {
+      typedef typename BOOST_REGEX_DETAIL_NS::is_byte<charT>::width_type width_type;
+      const BOOST_REGEX_DETAIL_NS::dfa_program* p = 0;
+      if(!e.empty() && !(e.flags() & regex_constants::failbit))
+         p = BOOST_REGEX_DETAIL_NS::get_set_member_program(e, static_cast<width_type*>(0));
+      if(m_program.use_count() > 1)
+      {
+         // shared with a copy of this set, which mustn't see the change:
+         m_program.reset(new BOOST_REGEX_DETAIL_NS::regex_set_program(*m_program));
+      }
+      m_members.push_back(e);
+      m_program->add(p, p ? e.get_map() : 0, p ? e.can_be_null() : false);
+      // the DFA's states are no good for the new program:
+      m_dfas.reset(new pool_type());
+      return m_members.size() - 1;
+   }
+
+   size_type size()const
+   {
+      return m_members.size();
+   }
+   bool empty()const
+   {
+      return m_members.empty();
+   }
+   const regex_type& operator[](size_type i)const
+   {
+      return m_members[i];
+   }
+   void clear()
+   {
+      m_members.clear();
+      m_program.reset(new BOOST_REGEX_DETAIL_NS::regex_set_program());
+      m_dfas.reset(new pool_type());
+   }
+
+   //
+   // private interface, used by regex_search:
+   //
+   const BOOST_REGEX_DETAIL_NS::regex_set_program& get_program()const
+   {
+      return *m_program;
+   }
+   const pool_type& get_dfas()const
+   {
+      return *m_dfas;
+   }
+
+private:
+   std::vector<regex_type>                                   m_members;
+   std::shared_ptr<BOOST_REGEX_DETAIL_NS::regex_set_program> m_program;  // shared by copies until one of them changes
+   std::shared_ptr<pool_type>                                m_dfas;     // spare DFA's for m_program, shared likewise
+};
+
+typedef basic_regex_set<char> regex_set;
+#ifndef BOOST_NO_WREGEX
+typedef basic_regex_set<wchar_t> wregex_set;
+#endif
+
+namespace BOOST_REGEX_DETAIL_NS{
+
+/*** class regex_set_search_state *************************************
+Runs the merged program of a set, if it has one that can be used with
+flags, and afterwards tells us which of the expressions still need to
+be searched for one at a time.
+***********************************************************************/
+template <class charT, class traits>
+class regex_set_search_state
+{
+public:
+   template <class BidiIterator>
+   regex_set_search_state(const basic_regex_set<charT, traits>& s, BidiIterator first, BidiIterator last, match_flag_type flags)
+      : m_set(s), m_dfa(0), m_done(false), m_flags(flags)
+   {
+      const match_flag_type unsupported = regex_constants::match_partial | regex_constants::match_posix | regex_constants::match_extra
+         | regex_constants::match_not_null | regex_constants::match_all | regex_constants::match_not_initial_null;
+      if(s.get_program().program_count() && ((flags & unsupported) == 0))
+      {
+         m_dfa = s.get_dfas().acquire();
+         m_dfa->init(&s.get_program());
+         m_done = m_dfa->find(first, last, flags);
+      }
+   }
+   ~regex_set_search_state()
+   {
+      if(m_dfa)
+         m_set.get_dfas().release(m_dfa);
+   }
+   // whether expression i has to be searched for on its own:
+   bool separate(std::size_t i)const
+   {
+      return !m_done || (m_set.get_program().starts()[i] == regex_set_no_program)
+         || (((m_flags & regex_constants::match_continuous) == 0) && m_set.get_program().skips_starts(i, m_flags));
+   }
+   // whether expression i matches, if it's not separate:
+   bool found(std::size_t i)const
+   {
+      return m_dfa->found(i);
+   }
+
+private:
+   regex_set_search_state(const regex_set_search_state&);
+   regex_set_search_state& operator=(const regex_set_search_state&);
+
+   const basic_regex_set<charT, traits>& m_set;
+   regex_set_dfa*                        m_dfa;
+   bool                                  m_done;   // whether the DFA finished
+   match_flag_type                       m_flags;  // the flags searched with
+};
+
+} // namespace BOOST_REGEX_DETAIL_NS
+
+//
+// Finds which of the expressions in s match somewhere in [first, last),
+// and stores their ids, in ascending order, in ids.  Each expression
+// matches if regex_search would find a match with match_linear set:
+//
+template <class BidiIterator, class charT, class traits>
+bool regex_search(BidiIterator first, BidiIterator last,
+                  std::vector<std::size_t>& ids,
+                  const basic_regex_set<charT, traits>& s,
+                  match_flag_type flags = match_default)
+{
+   ids.clear();
+   BOOST_REGEX_DETAIL_NS::regex_set_search_state<charT, traits> state(s, first, last, flags);
+   for(std::size_t i = 0; i < s.size(); ++i)
+   {
+      bool found;
+      if(state.separate(i))
+         found = !s[i].empty() && regex_search(first, last, s[i], flags | regex_constants::match_linear);
+      else
+         found = state.found(i);
+      if(found)
+         ids.push_back(i);
+   }
+   return !ids.empty();
+}
+
+//
+// As above, but sets element i of matches to the first match of
+// expression i, or leaves it unmatched:
+//
+template <class BidiIterator, class charT, class traits>
+bool regex_search(BidiIterator first, BidiIterator last,
+                  std::vector<sub_match<BidiIterator> >& matches,
+                  const basic_regex_set<charT, traits>& s,
+                  match_flag_type flags = match_default)
+{
+   sub_match<BidiIterator> none;
+   none.first = none.second = last;
+   none.matched = false;
+   matches.assign(s.size(), none);
+   bool result = false;
+   match_results<BidiIterator> what;
+   BOOST_REGEX_DETAIL_NS::regex_set_search_state<charT, traits> state(s, first, last, flags);
+   for(std::size_t i = 0; i < s.size(); ++i)
+   {
+      // only the expressions we know to match need looking at again:
+      if((state.separate(i) || state.found(i)) && !s[i].empty() && regex_search(first, last, what, s[i], flags | regex_constants::match_linear))
+      {
+         matches[i] = what[0];
+         result = true;
+      }
+   }
+   return result;
+}
+
+//
+// regex_search convenience interfaces:
+//
+template <class ST, class SA, class charT, class traits>
+inline bool regex_search(const std::basic_string<charT, ST, SA>& text,
+                         std::vector<std::size_t>& ids,
+                         const basic_regex_set<charT, traits>& s,
+                         match_flag_type flags = match_default)
+{
+   return regex_search(text.begin(), text.end(), ids, s, flags);
+}
+
+template <class charT, class traits>
+inline bool regex_search(const charT* text,
+                         std::vector<std::size_t>& ids,
+                         const basic_regex_set<charT, traits>& s,
+                         match_flag_type flags = match_default)
+{
+   return regex_search(text, text + traits::length(text), ids, s, flags);
+}
+
+} // namespace boost
+
+#endif
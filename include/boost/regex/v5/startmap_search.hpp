@@ -0,0 +1,460 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         startmap_search.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares class startmap_search, used to skip over
+  *                narrow characters which can not start a match, and
+  *                the kernels used to run through narrow single
+  *                character repeats, and to back up over them.
+  */
+
+#ifndef BOOST_REGEX_V5_STARTMAP_SEARCH_HPP
+#define BOOST_REGEX_V5_STARTMAP_SEARCH_HPP
+
+#include <boost/regex/config.hpp>
+#include <climits>
+#include <cstring>
+
+#ifdef BOOST_REGEX_HAS_SSE2
+#include <emmintrin.h>
+#ifdef BOOST_REGEX_MSVC
+#include <intrin.h>
+#endif
+#endif
+#ifdef BOOST_REGEX_HAS_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace boost{
+namespace BOOST_REGEX_DETAIL_NS{
+
+#ifdef BOOST_REGEX_HAS_SSE2
+inline unsigned find_lowest_bit(unsigned v)
+{
+#ifdef BOOST_REGEX_MSVC
+   unsigned long result;
+   _BitScanForward(&result, v);
+   return static_cast<unsigned>(result);
+#else
+   return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+}
+inline unsigned find_highest_bit(unsigned v)
+{
+#ifdef BOOST_REGEX_MSVC
+   unsigned long result;
+   _BitScanReverse(&result, v);
+   return static_cast<unsigned>(result);
+#else
+   return static_cast<unsigned>(31 - __builtin_clz(v));
+#endif
+}
+#endif
+
+#ifdef BOOST_REGEX_HAS_SIMD_DISPATCH
+//
+// 0 = SSE2 only, 1 = SSSE3, 2 = AVX2, checked once:
+//
+inline int get_simd_level()
+{
+   static const int level = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") ? 2 : __builtin_cpu_supports("ssse3") ? 1 : 0);
+   return level;
+}
+#endif
+
+/*** class startmap_search ********************************************
+A summary of a start map which lets us search narrow strings for
+characters that can start a match a block at a time, rather than
+looking each character up in turn:
+
+When only one character can start a match we use memchr, for two or
+three characters we compare each block against each of them, otherwise
+we use "shufti" style nibble tables: the high nibbles of the set are
+grouped into at most 8 buckets, each having a mask of the low nibbles
+that go with it.  If there are more than 8 distinct low nibble masks
+then the extra ones are merged, so the tables find a superset of the
+characters, and each candidate is checked against the map itself.
+***********************************************************************/
+class startmap_search
+{
+public:
+   startmap_search() : m_count(0), m_mask(0), m_chars{ 0 }, m_lo{ 0 }, m_hi{ 0 } {}
+
+   void assign(const unsigned char* map, unsigned char mask)
+   {
+      unsigned low_masks[16] = { 0 };
+      unsigned buckets[8] = { 0 };
+      unsigned bucket_count = 0;
+      m_count = 0;
+      m_mask = mask;
+      for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
+      {
+         if(map[i] & mask)
+         {
+            if(m_count < 3)
+               m_chars[m_count] = static_cast<unsigned char>(i);
+            ++m_count;
+            low_masks[(i >> 4) & 0xF] |= 1u << (i & 0xF);
+         }
+      }
+      std::memset(m_lo, 0, sizeof(m_lo));
+      std::memset(m_hi, 0, sizeof(m_hi));
+      for(unsigned h = 0; h < 16; ++h)
+      {
+         if(low_masks[h] == 0)
+            continue;
+         unsigned b = 0;
+         while((b < bucket_count) && (buckets[b] != low_masks[h]))
+            ++b;
+         if(b == bucket_count)
+         {
+            if(bucket_count < 8)
+               ++bucket_count;
+            else
+               b = 7;  // out of buckets, merge with the last one
+         }
+         buckets[b] |= low_masks[h];
+         m_hi[h] = static_cast<unsigned char>(1u << b);
+      }
+      for(unsigned b = 0; b < bucket_count; ++b)
+      {
+         for(unsigned l = 0; l < 16; ++l)
+         {
+            if(buckets[b] & (1u << l))
+               m_lo[l] |= static_cast<unsigned char>(1u << b);
+         }
+      }
+   }
+   //
+   // Returns the first position in [p, e) which may start a match
+   // according to map, or e if there isn't one:
+   //
+   const unsigned char* find(const unsigned char* p, const unsigned char* e, const unsigned char* map)const
+   {
+      // don't bother with anything clever if the first character will do:
+      if((p == e) || (map[*p] & m_mask))
+         return p;
+      if(m_count == 0)
+         return e;
+      if(m_count == 1)
+      {
+         const void* pos = std::memchr(p, m_chars[0], static_cast<std::size_t>(e - p));
+         return pos ? static_cast<const unsigned char*>(pos) : e;
+      }
+#ifdef BOOST_REGEX_HAS_SIMD_DISPATCH
+      if(get_simd_level() == 2)
+         return find_avx2(p, e, map);
+      if((get_simd_level() == 1) && (m_count > 3))
+         return find_ssse3(p, e, map);
+#endif
+#ifdef BOOST_REGEX_HAS_SSE2
+      if(m_count <= 3)
+         return find_sse2(p, e, map);
+#endif
+      return find_scalar(p, e, map);
+   }
+private:
+   const unsigned char* find_scalar(const unsigned char* p, const unsigned char* e, const unsigned char* map)const
+   {
+      while((p != e) && !(map[*p] & m_mask))
+         ++p;
+      return p;
+   }
+#ifdef BOOST_REGEX_HAS_SSE2
+   const unsigned char* find_sse2(const unsigned char* p, const unsigned char* e, const unsigned char* map)const
+   {
+      const __m128i c0 = _mm_set1_epi8(static_cast<char>(m_chars[0]));
+      const __m128i c1 = _mm_set1_epi8(static_cast<char>(m_chars[1]));
+      const __m128i c2 = _mm_set1_epi8(static_cast<char>(m_chars[m_count > 2 ? 2 : 1]));
+      while(e - p >= 16)
+      {
+         __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+         __m128i r = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, c0), _mm_cmpeq_epi8(v, c1)), _mm_cmpeq_epi8(v, c2));
+         unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(r));
+         if(bits)
+            return p + find_lowest_bit(bits);
+         p += 16;
+      }
+      return find_scalar(p, e, map);
+   }
+#endif
+#ifdef BOOST_REGEX_HAS_SIMD_DISPATCH
+   __attribute__((target("ssse3")))
+   const unsigned char* find_ssse3(const unsigned char* p, const unsigned char* e, const unsigned char* map)const
+   {
+      const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_lo));
+      const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_hi));
+      const __m128i nibble = _mm_set1_epi8(0x0F);
+      const __m128i zero = _mm_setzero_si128();
+      while(e - p >= 16)
+      {
+         __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+         __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(v, nibble));
+         __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+         unsigned bits = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(l, h), zero))) & 0xFFFFu;
+         while(bits)
+         {
+            const unsigned char* pos = p + find_lowest_bit(bits);
+            if(map[*pos] & m_mask)
+               return pos;
+            bits &= bits - 1;
+         }
+         p += 16;
+      }
+      return find_scalar(p, e, map);
+   }
+   __attribute__((target("avx2")))
+   const unsigned char* find_avx2(const unsigned char* p, const unsigned char* e, const unsigned char* map)const
+   {
+      const __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m_lo)));
+      const __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m_hi)));
+      const __m256i nibble = _mm256_set1_epi8(0x0F);
+      const __m256i zero = _mm256_setzero_si256();
+      while(e - p >= 32)
+      {
+         __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+         __m256i l = _mm256_shuffle_epi8(lo, _mm256_and_si256(v, nibble));
+         __m256i h = _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+         unsigned bits = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(l, h), zero)));
+         while(bits)
+         {
+            const unsigned char* pos = p + find_lowest_bit(bits);
+            if(map[*pos] & m_mask)
+               return pos;
+            bits &= bits - 1;
+         }
+         p += 32;
+      }
+      return find_scalar(p, e, map);
+   }
+#endif
+
+   unsigned       m_count;     // how many characters can start a match
+   unsigned char  m_mask;      // the mask we test the map against
+   unsigned char  m_chars[3];  // the first three such characters
+   unsigned char  m_lo[16];    // bucket bits for each low nibble
+   unsigned char  m_hi[16];    // bucket bit for each high nibble
+};
+
+/*** struct span_search ***********************************************
+Nibble tables for a set of narrow characters, in the same form as
+those of startmap_search, but used the other way around: to find the
+first character which is *not* in the set, so that a repeat of the set
+can run through its input a block at a time.  The tables are only
+built when eight buckets describe the set exactly, so there are no
+candidates to check.  This lives inside re_set states, so it has no
+constructor and must be filled in with assign.
+***********************************************************************/
+struct span_search
+{
+   enum
+   {
+      no_tables = 0,         // the set is too irregular for the tables
+      case_sensitive = 1,    // tables built for matching with case
+      case_insensitive = 2   // tables built for matching without case
+   };
+   //
+   // Builds the tables, member[c] being non-zero for each character c
+   // which is in the set *before* translation:
+   //
+   void assign(const unsigned char* member, bool icase)
+   {
+      unsigned low_masks[16] = { 0 };
+      unsigned buckets[8] = { 0 };
+      unsigned bucket_count = 0;
+      for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
+      {
+         if(member[i])
+            low_masks[(i >> 4) & 0xF] |= 1u << (i & 0xF);
+      }
+      std::memset(m_lo, 0, sizeof(m_lo));
+      std::memset(m_hi, 0, sizeof(m_hi));
+      m_state = no_tables;
+      for(unsigned h = 0; h < 16; ++h)
+      {
+         if(low_masks[h] == 0)
+            continue;
+         unsigned b = 0;
+         while((b < bucket_count) && (buckets[b] != low_masks[h]))
+            ++b;
+         if(b == bucket_count)
+         {
+            if(bucket_count == 8)
+               return;
+            buckets[bucket_count++] = low_masks[h];
+         }
+         m_hi[h] = static_cast<unsigned char>(1u << b);
+      }
+      for(unsigned b = 0; b < bucket_count; ++b)
+      {
+         for(unsigned l = 0; l < 16; ++l)
+         {
+            if(buckets[b] & (1u << l))
+               m_lo[l] |= static_cast<unsigned char>(1u << b);
+         }
+      }
+      m_state = static_cast<unsigned char>(icase ? case_insensitive : case_sensitive);
+   }
+   bool usable(bool icase)const
+   {
+      return m_state == (icase ? case_insensitive : case_sensitive);
+   }
+   bool contains(unsigned char c)const
+   {
+      return (m_lo[c & 0xF] & m_hi[c >> 4]) != 0;
+   }
+   //
+   // Returns the first position in [p, e) which is not in the set,
+   // or e if there isn't one:
+   //
+   const unsigned char* find_not(const unsigned char* p, const unsigned char* e)const
+   {
+#ifdef BOOST_REGEX_HAS_SIMD_DISPATCH
+      if(get_simd_level() == 2)
+         return find_not_avx2(p, e);
+      if(get_simd_level() == 1)
+         return find_not_ssse3(p, e);
+#endif
+      return find_not_scalar(p, e);
+   }
+private:
+   const unsigned char* find_not_scalar(const unsigned char* p, const unsigned char* e)const
+   {
+      while((p != e) && contains(*p))
+         ++p;
+      return p;
+   }
+#ifdef BOOST_REGEX_HAS_SIMD_DISPATCH
+   __attribute__((target("ssse3")))
+   const unsigned char* find_not_ssse3(const unsigned char* p, const unsigned char* e)const
+   {
+      const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_lo));
+      const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_hi));
+      const __m128i nibble = _mm_set1_epi8(0x0F);
+      const __m128i zero = _mm_setzero_si128();
+      while(e - p >= 16)
+      {
+         __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+         __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(v, nibble));
+         __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+         unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(l, h), zero)));
+         if(bits)
+            return p + find_lowest_bit(bits);
+         p += 16;
+      }
+      return find_not_scalar(p, e);
+   }
+   __attribute__((target("avx2")))
+   const unsigned char* find_not_avx2(const unsigned char* p, const unsigned char* e)const
+   {
+      const __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m_lo)));
+      const __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m_hi)));
+      const __m256i nibble = _mm256_set1_epi8(0x0F);
+      const __m256i zero = _mm256_setzero_si256();
+      while(e - p >= 32)
+      {
+         __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+         __m256i l = _mm256_shuffle_epi8(lo, _mm256_and_si256(v, nibble));
+         __m256i h = _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+         unsigned bits = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(l, h), zero)));
+         if(bits)
+            return p + find_lowest_bit(bits);
+         p += 32;
+      }
+      return find_not_ssse3(p, e);
+   }
+#endif
+public:
+   unsigned char  m_state;     // one of the enumerated values above
+   unsigned char  m_lo[16];    // bucket bits for each low nibble
+   unsigned char  m_hi[16];    // bucket bit for each high nibble
+};
+
+//
+// Returns the first position in [p, e) which isn't c, or e:
+//
+inline const unsigned char* find_not_char(const unsigned char* p, const unsigned char* e, unsigned char c)
+{
+#ifdef BOOST_REGEX_HAS_SSE2
+   const __m128i vc = _mm_set1_epi8(static_cast<char>(c));
+   while(e - p >= 16)
+   {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      unsigned bits = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vc))) & 0xFFFFu;
+      if(bits)
+         return p + find_lowest_bit(bits);
+      p += 16;
+   }
+#endif
+   while((p != e) && (*p == c))
+      ++p;
+   return p;
+}
+
+//
+// Returns the first line separator in [p, e) if separators is set, or
+// the first nul if nul is set, or e if there isn't one:
+//
+inline const unsigned char* find_separator(const unsigned char* p, const unsigned char* e, bool separators, bool nul)
+{
+#ifdef BOOST_REGEX_HAS_SSE2
+   // with only one of the two wanted, the unwanted comparisons repeat a wanted one:
+   const char first = separators ? '\n' : 0;
+   const __m128i lf = _mm_set1_epi8(first);
+   const __m128i cr = _mm_set1_epi8(separators ? '\r' : first);
+   const __m128i ff = _mm_set1_epi8(separators ? '\f' : first);
+   const __m128i extra = _mm_set1_epi8(nul ? 0 : first);
+   while(e - p >= 16)
+   {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      __m128i r = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)), _mm_or_si128(_mm_cmpeq_epi8(v, ff), _mm_cmpeq_epi8(v, extra)));
+      unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(r));
+      if(bits)
+         return p + find_lowest_bit(bits);
+      p += 16;
+   }
+#endif
+   while((p != e) && !(separators && ((*p == '\n') || (*p == '\r') || (*p == '\f'))) && (!nul || (*p != 0)))
+      ++p;
+   return p;
+}
+
+//
+// Returns the last c in [p, e), or e if there isn't one:
+//
+inline const unsigned char* rfind_char(const unsigned char* p, const unsigned char* e, unsigned char c)
+{
+   const unsigned char* pos = e;
+#ifdef BOOST_REGEX_HAS_SSE2
+   const __m128i vc = _mm_set1_epi8(static_cast<char>(c));
+   while(pos - p >= 16)
+   {
+      pos -= 16;
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+      unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vc)));
+      if(bits)
+         return pos + find_highest_bit(bits);
+   }
+#endif
+   while(pos != p)
+   {
+      if(*--pos == c)
+         return pos;
+   }
+   return e;
+}
+
+} // namespace BOOST_REGEX_DETAIL_NS
+} // namespace boost
+
+#endif
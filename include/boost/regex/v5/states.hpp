@@ -19,6 +19,13 @@
 #ifndef BOOST_REGEX_V5_STATES_HPP
 #define BOOST_REGEX_V5_STATES_HPP
 
+#include <boost/regex/v5/iterator_category.hpp>
+#include <boost/regex/v5/startmap_search.hpp>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
 namespace boost{
 namespace BOOST_REGEX_DETAIL_NS{
 
@@ -26,7 +33,8 @@ namespace BOOST_REGEX_DETAIL_NS{
 Whenever we have a choice of two alternatives, we use an array of bytes
 to indicate which of the two alternatives it is possible to take for any
 given input character.  If mask_take is set, then we can take the next 
-state, and if mask_skip is set then we can take the alternative.
+state, and if mask_skip is set then we can take the alternative.  Once
+built, the states keep one re_bitmap for each of the two instead.
 ***********************************************************************/
 enum mask_type
 {
@@ -49,6 +57,67 @@ template<>             struct is_byte<unsigned char>{ typedef _narrow_type width
 template<>             struct is_byte<signed char>  { typedef _narrow_type width_type; };
 template <class charT> struct is_byte               { typedef _wide_type width_type; };
 
+//
+// is_byte_array<I>::value is true when I refers to narrow characters
+// held one after another in memory, which can then be searched a block
+// at a time through the pointer returned by array_pointer:
+//
+template <class I>
+struct is_byte_array
+{
+private:
+   typedef typename std::iterator_traits<I>::value_type value_type;
+public:
+   static const bool value = ::boost::is_contiguous_iterator<I>::value
+      && std::is_same<typename is_byte<value_type>::width_type, _narrow_type>::value;
+};
+template <class I>
+inline const typename std::iterator_traits<I>::value_type* array_pointer(I i)
+{
+   return std::addressof(*i);
+}
+
+/*** struct re_bitmap ************************************************
+A set of narrow characters, one bit per character, so that the maps
+held by each state take up 32 bytes rather than 256.
+***********************************************************************/
+struct re_bitmap
+{
+   enum{ word_bits = 32, word_count = (1u << CHAR_BIT) / word_bits };
+
+   bool test(unsigned char c)const
+   {
+      return (m_words[c / word_bits] >> (c % word_bits)) & 1u;
+   }
+   void set(unsigned char c)
+   {
+      m_words[c / word_bits] |= static_cast<std::uint32_t>(1u) << (c % word_bits);
+   }
+   void clear()
+   {
+      std::memset(m_words, 0, sizeof(m_words));
+   }
+   void flip()
+   {
+      for(unsigned i = 0; i < word_count; ++i)
+         m_words[i] = ~m_words[i];
+   }
+   //
+   // Fills in the bits for which map[i] & mask is non-zero:
+   //
+   void assign(const unsigned char* map, unsigned char mask)
+   {
+      clear();
+      for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
+      {
+         if(map[i] & mask)
+            set(static_cast<unsigned char>(i));
+      }
+   }
+
+   std::uint32_t m_words[word_count];
+};
+
 /*** enum syntax_element_type ******************************************
 Every record in the state machine falls into one of the following types:
 ***********************************************************************/
@@ -207,11 +276,12 @@ struct re_set_long : public re_syntax_base
 };
 
 /*** struct re_set ****************************************************
-A set of narrow-characters, matches any of _map which is none-zero
+A set of narrow-characters, matches any of _map which is set
 ***********************************************************************/
 struct re_set : public re_syntax_base
 {
-   unsigned char _map[1 << CHAR_BIT];
+   re_bitmap     _map;
+   span_search   _span;   // used to run through repeats of the set a block at a time
 };
 
 /*** struct re_jump ***************************************************
@@ -227,8 +297,9 @@ Jump to a new location in the machine (possibly next).
 ***********************************************************************/
 struct re_alt : public re_jump
 {
-   unsigned char   _map[1 << CHAR_BIT]; // which characters can take the jump
-   unsigned int    can_be_null;         // true if we match a NULL string
+   re_bitmap       _take_map;           // which characters can take the next state
+   re_bitmap       _skip_map;           // which characters can take the jump
+   unsigned int    can_be_null;         // mask_take/mask_skip if we match a NULL string, plus mask_init once the maps are built
 };
 
 /*** struct re_repeat *************************************************
@@ -240,6 +311,8 @@ struct re_repeat : public re_alt
    int           state_id;        // Unique identifier for this repeat
    bool          leading;   // True if this repeat is at the start of the machine (lets us optimize some searches)
    bool          greedy;    // True if this is a greedy repeat
+   bool          possessive; // True if giving back characters can never lead to a match, so there's no need to save state
+   std::ptrdiff_t following_literal; // Offset from a single character repeat to the literal which has to match after it, or zero
 };
 
 /*** struct re_recurse ************************************************
@@ -29,6 +29,8 @@
 #include <boost/regex/v5/primary_transform.hpp>
 #include <boost/regex/v5/object_cache.hpp>
 
+#include <map>
+
 #ifndef VC_EXTRALEAN
 #  define VC_EXTRALEAN
 #endif
@@ -0,0 +1,73 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_corpus.hpp"
+#include <string>
+
+#ifdef BOOST_INTEL
+#pragma warning(disable:1418 981 983 383)
+#endif
+
+//
+// The results must be the same as without a context, however many
+// different expressions and inputs the context has seen before:
+//
+void check(const boost::regex& e, boost::regex_match_context<std::string::const_iterator>& context)
+{
+   for(std::size_t i = 0; i < corpus_text_count; ++i)
+      check_unchanged(e, std::string(corpus_texts[i]), context);
+}
+
+int cpp_main( int , char* [] )
+{
+   boost::regex_match_context<std::string::const_iterator> context;
+
+   for(std::size_t i = 0; i < corpus_pattern_count; ++i)
+      check(boost::regex(corpus_patterns[i]), context);
+   check(boost::regex("(a|ab)(c|bcd)?", boost::regex::extended), context);  // POSIX leftmost longest
+   check(boost::regex("((a*)|b)*b", boost::regex::extended), context);
+   check(boost::regex("(\\w)\\1+"), context);
+
+   // named sub-expressions come from the expression last searched for:
+   std::string text("key=value");
+   boost::smatch what;
+   BOOST_CHECK(boost::regex_search(text, what, boost::regex("(?<k>\\w+)="), context));
+   BOOST_CHECK(what["k"].str() == "key");
+   BOOST_CHECK(boost::regex_search(text, what, boost::regex("=(?<v>\\w+)"), context));
+   BOOST_CHECK(what["v"].str() == "value");
+   BOOST_CHECK(!what["k"].matched);
+
+   // a search that gives up with an exception leaves the context usable:
+   std::string bad_text("xyz");
+   bad_text.append(1024, ' ');
+   BOOST_CHECK_THROW(boost::regex_search(bad_text, what, boost::regex("(.+)+\\1xyz"), context), std::runtime_error);
+   check(boost::regex("a+|b+"), context);
+
+   // as do copies, and clear():
+   boost::regex_match_context<std::string::const_iterator> copy(context);
+   check(boost::regex("(\\w)\\1+"), copy);
+   context.clear();
+   check(boost::regex("\\(((?:[^()]|(?R))*)\\)"), context);
+
+   // pointers and wide characters:
+   boost::regex_match_context<const char*> ccontext;
+   boost::cmatch cwhat;
+   BOOST_CHECK(boost::regex_search("one two", cwhat, boost::regex("t(\\w+)"), ccontext));
+   BOOST_CHECK(cwhat.str(1) == "wo");
+   BOOST_CHECK(boost::regex_match("one two", boost::regex("\\w+ \\w+"), ccontext));
+   BOOST_CHECK(!boost::regex_match("one two", cwhat, boost::regex("\\w+"), ccontext));
+#if !defined(BOOST_NO_WREGEX)
+   boost::regex_match_context<const wchar_t*> wcontext;
+   BOOST_CHECK(boost::regex_search(L"one two", boost::wregex(L"t\\w+"), wcontext));
+#endif
+   return 0;
+}
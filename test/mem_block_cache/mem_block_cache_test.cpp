@@ -0,0 +1,92 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE:        mem_block_cache_test.cpp
+  *   VERSION:     see <boost/version.hpp>
+  *   DESCRIPTION: Test that the memory blocks used by the matcher are
+  *                cached, and all given back, when matching from many threads.
+  */
+
+#define BOOST_REGEX_MEM_BLOCK_STATISTICS
+
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_macros.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef BOOST_INTEL
+#pragma warning(disable:1418 981 983 383)
+#endif
+
+static const int iterations = 2000;
+
+void search(const boost::regex* e, int* found)
+{
+   std::string text("aaaa bbbb abab (a(b)c) key=value");
+   boost::smatch what;
+   for(int i = 0; i < iterations; ++i)
+   {
+      if(boost::regex_search(text, what, *e))
+         ++*found;
+   }
+}
+
+int cpp_main( int , char* [] )
+{
+   boost::regex e("\\(((?:[^()]|(?R))*)\\)|(\\w+)=(\\w+)$");
+   boost::reset_regex_mem_block_statistics();
+
+   int found = 0;
+   search(&e, &found);
+   BOOST_CHECK(found == iterations);
+   boost::regex_mem_block_statistics stats = boost::get_regex_mem_block_statistics();
+   BOOST_CHECK(stats.in_use == 0);
+   BOOST_CHECK(stats.thread_hits + stats.global_hits + stats.allocations >= static_cast<std::size_t>(iterations));
+   // only the first search should have needed a new block:
+   BOOST_CHECK(stats.allocations <= 1);
+   BOOST_CHECK(stats.hit_rate() > 0.99);
+
+   {
+      // a context holds on to its block between searches:
+      boost::regex_match_context<std::string::const_iterator> context;
+      std::string text("(a(b)c)");
+      boost::smatch what;
+      BOOST_CHECK(boost::regex_search(text, what, e, context));
+      BOOST_CHECK(boost::get_regex_mem_block_statistics().in_use == 1);
+      boost::reset_regex_mem_block_statistics();
+      BOOST_CHECK(boost::regex_search(text, what, e, context));
+      stats = boost::get_regex_mem_block_statistics();
+      BOOST_CHECK(stats.thread_hits + stats.global_hits + stats.allocations == 0);
+      BOOST_CHECK(stats.in_use == 1);
+   }
+   BOOST_CHECK(boost::get_regex_mem_block_statistics().in_use == 0);
+
+   boost::reset_regex_mem_block_statistics();
+   std::vector<int> counts(8, 0);
+   std::vector<std::thread> threads;
+   for(std::size_t i = 0; i < counts.size(); ++i)
+      threads.push_back(std::thread(search, &e, &counts[i]));
+   for(std::size_t i = 0; i < threads.size(); ++i)
+      threads[i].join();
+   for(std::size_t i = 0; i < counts.size(); ++i)
+      BOOST_CHECK(counts[i] == iterations);
+   stats = boost::get_regex_mem_block_statistics();
+   BOOST_CHECK(stats.in_use == 0);
+   BOOST_CHECK(stats.hit_rate() > 0.99);
+#if BOOST_REGEX_MAX_THREAD_CACHE_BLOCKS > 0
+   // each thread needs a block of its own to start with, after that it uses its own cache:
+   BOOST_CHECK(stats.thread_hits >= counts.size() * (iterations - 1));
+#endif
+   return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         object_cache_scaling.cpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Measures how lookups in object_cache, and the
+  *                construction of regular expressions which goes
+  *                through it, scale with the number of threads.
+  */
+
+#include <boost/regex.hpp>
+#include <boost/regex/v5/object_cache.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_macros.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+class scaling_object
+{
+public:
+   scaling_object(int i) : m_value(i) {}
+   int value()const { return m_value; }
+private:
+   int m_value;
+};
+
+static const int key_count = 8;
+static const int lookups = 200000;
+static const int constructions = 2000;
+
+void lookup(int seed, int* bad)
+{
+   for(int i = 0; i < lookups; ++i)
+   {
+      int k = (i + seed) % key_count;
+      if(boost::object_cache<int, scaling_object>::get(k, key_count)->value() != k)
+         ++*bad;
+   }
+}
+
+void construct(int, int* bad)
+{
+   // each of these looks up the traits implementation for the global locale:
+   for(int i = 0; i < constructions; ++i)
+   {
+      boost::regex e("(a+)b");
+      if(e.mark_count() != 1)
+         ++*bad;
+   }
+}
+
+double run(void (*proc)(int, int*), unsigned threads)
+{
+   std::vector<int> bad(threads, 0);
+   std::vector<std::thread> workers;
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   for(unsigned i = 0; i < threads; ++i)
+      workers.push_back(std::thread(proc, static_cast<int>(i), &bad[i]));
+   for(unsigned i = 0; i < threads; ++i)
+      workers[i].join();
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+   for(unsigned i = 0; i < threads; ++i)
+      BOOST_CHECK(bad[i] == 0);
+   return elapsed.count();
+}
+
+int cpp_main(int /*argc*/, char * /*argv*/[])
+{
+   unsigned max_threads = std::thread::hardware_concurrency();
+   if(max_threads < 4)
+      max_threads = 4;
+   std::cout << std::setw(8) << "threads" << std::setw(20) << "lookups/s" << std::setw(20) << "regex ctors/s" << std::endl;
+   for(unsigned threads = 1; threads <= max_threads; threads *= 2)
+   {
+      double get_time = run(lookup, threads);
+      double ctor_time = run(construct, threads);
+      std::cout << std::setw(8) << threads
+         << std::setw(20) << static_cast<long long>(threads * static_cast<double>(lookups) / get_time)
+         << std::setw(20) << static_cast<long long>(threads * static_cast<double>(constructions) / ctor_time) << std::endl;
+   }
+   return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE:        parallel_search_test.cpp
+  *   VERSION:     see <boost/version.hpp>
+  *   DESCRIPTION: Test that parallel_regex_search_all finds exactly what
+  *                regex_iterator does.
+  */
+
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_corpus.hpp"
+#include <string>
+#include <vector>
+
+#ifdef BOOST_INTEL
+#pragma warning(disable:1418 981 983 383)
+#endif
+
+//
+// As well as the shared expressions, some whose matches can span chunks,
+// or which have to be searched for in order:
+//
+static const char* chunk_patterns[] =
+{
+   "\\<\\w+\\>",                    // a match in every word
+   "\\w+=\\w+$",
+   "a[^z]*z",                       // matches that span lines and chunks
+   "[[:space:]]+",
+   "ERROR.{0,20}line \\d+",         // required literal some way in
+   "\\Gline",                       // has to be searched in order
+   "\\n\\n",
+};
+
+std::string make_text()
+{
+   std::string text;
+   for(int i = 0; i < 3000; ++i)
+   {
+      text += "line " + std::to_string(i) + ": ";
+      if(i % 7 == 0)
+         text += "error id=" + std::to_string(i * 13) + " ";
+      if(i % 11 == 0)
+         text += "ERROR in line " + std::to_string(i) + " ";
+      if(i % 29 == 0)
+         text += "a very long match which spans ";
+      if(i % 31 == 0)
+         text += "lines until z ";
+      if(i % 17 == 0)
+         text += "timeout key=value";
+      if(i % 13 == 0)
+         text += "\n";
+      text += "aabbcc\n";
+   }
+   return text;
+}
+
+void check(const std::string& text, const boost::regex& e, boost::match_flag_type flags, std::size_t threads)
+{
+   check_same_matches(boost::parallel_regex_search_all(text, e, flags, threads), all_matches(text, e, flags), e);
+}
+
+void check_all(const std::string& text, const boost::regex& e)
+{
+   static const boost::match_flag_type flags[] =
+   {
+      boost::match_default,
+      boost::match_not_null,
+      boost::match_not_dot_newline,
+      boost::match_posix,
+   };
+   static const std::size_t threads[] = { 1, 3, 16, 0 };
+   for(std::size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); ++f)
+   {
+      for(std::size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t)
+         check(text, e, flags[f], threads[t]);
+   }
+}
+
+int cpp_main( int , char* [] )
+{
+   std::string text = make_text();
+   for(std::size_t i = 0; i < corpus_pattern_count; ++i)
+      check_all(text, boost::regex(corpus_patterns[i]));
+   for(std::size_t i = 0; i < sizeof(chunk_patterns) / sizeof(chunk_patterns[0]); ++i)
+      check_all(text, boost::regex(chunk_patterns[i]));
+   // POSIX leftmost longest:
+   check(text, boost::regex("(ab|a)(c|bcd)?|b+c+", boost::regex::extended), boost::match_default, 16);
+   // an input too short to split:
+   check(std::string("error error"), boost::regex("error"), boost::match_default, 16);
+   check(std::string(), boost::regex("x*"), boost::match_default, 16);
+   return 0;
+}
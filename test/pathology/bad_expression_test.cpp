@@ -27,7 +27,10 @@
 
 int cpp_main( int , char* [] )
 {
-   std::string bad_text(1024, ' ');
+   // the literals the expressions require are present, but in the wrong
+   // place, so that they don't stop the matcher from even trying:
+   std::string bad_text("xyz");
+   bad_text.append(1024, ' ');
    std::string good_text(200, ' ');
    good_text.append("xyz");
 
@@ -50,6 +53,7 @@ int cpp_main( int , char* [] )
    BOOST_CHECK(boost::regex_search(good_text, what, e2));
 
    bad_text.assign((std::string::size_type)500000, 'a');
+   bad_text.append("b@");
    e2.assign("aaa*@");
    BOOST_CHECK_THROW(boost::regex_search(bad_text, what, e2), std::runtime_error);
    good_text.assign((std::string::size_type)5000, 'a');
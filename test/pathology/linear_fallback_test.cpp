@@ -0,0 +1,78 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE:        linear_fallback_test.cpp
+  *   VERSION:     see <boost/version.hpp>
+  *   DESCRIPTION: Test that pathological expressions are matched in linear
+  *                time by match_linear, and by BOOST_REGEX_LINEAR_FALLBACK.
+  */
+
+#define BOOST_REGEX_LINEAR_FALLBACK
+
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_macros.hpp"
+#include <string>
+
+#ifdef BOOST_INTEL
+#pragma warning(disable:1418 981 983 383)
+#endif
+
+int cpp_main( int , char* [] )
+{
+   // as in bad_expression_test.cpp, these all throw without the fallback:
+   std::string bad_text("xyz");
+   bad_text.append(1024, ' ');
+   std::string good_text(200, ' ');
+   good_text.append("xyz");
+
+   boost::smatch what;
+
+   boost::regex e1("(.+)+xyz");
+
+   BOOST_CHECK(boost::regex_search(good_text, what, e1));
+   BOOST_CHECK(what.position() == 0);
+   BOOST_CHECK(what.position(1) == 0);
+   BOOST_CHECK(what.length(1) == 200);
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e1));
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e1, boost::match_linear));
+   BOOST_CHECK(boost::regex_search(good_text, what, e1, boost::match_linear));
+   BOOST_CHECK(what.length(1) == 200);
+
+   BOOST_CHECK(!boost::regex_match(bad_text, what, e1));
+   BOOST_CHECK(!boost::regex_match(bad_text, what, e1, boost::match_linear));
+   BOOST_CHECK(boost::regex_match(good_text, what, e1, boost::match_linear));
+
+   boost::regex e2("abc|[[:space:]]+(xyz)?[[:space:]]+xyz");
+
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e2));
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e2, boost::match_linear));
+   bad_text.append("xyz");
+   BOOST_CHECK(boost::regex_search(bad_text, what, e2, boost::match_linear));
+   BOOST_CHECK(what.position() == 3);
+   BOOST_CHECK(!what[1].matched);
+
+   bad_text.assign((std::string::size_type)500000, 'a');
+   bad_text.append("b@");
+   e2.assign("aaa*@");
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e2));
+   BOOST_CHECK(!boost::regex_search(bad_text, what, e2, boost::match_linear));
+
+   // back references can't be matched without backtracking, so still throw:
+   bad_text.assign("xyz");
+   bad_text.append(1024, ' ');
+   boost::regex e3("(.+)+\\1xyz");
+   BOOST_CHECK_THROW(boost::regex_search(bad_text, what, e3), std::runtime_error);
+   BOOST_CHECK_THROW(boost::regex_search(bad_text, what, e3, boost::match_linear), std::runtime_error);
+
+   return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE:        regex_cache_test.cpp
+  *   VERSION:     see <boost/version.hpp>
+  *   DESCRIPTION: Test that basic_regex_cache shares expressions, keeps
+  *                within its limits, and stays consistent when used
+  *                from many threads.
+  */
+
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_macros.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef BOOST_INTEL
+#pragma warning(disable:1418 981 983 383)
+#endif
+
+static const int iterations = 5000;
+static const int pattern_count = 40;
+
+std::string pattern(int i)
+{
+   return "key" + std::to_string(i) + "=(\\w+)";
+}
+
+void lookup(boost::regex_cache* cache, int seed, int* bad)
+{
+   for(int i = 0; i < iterations; ++i)
+   {
+      int n = (i * 7 + seed) % pattern_count;
+      std::shared_ptr<const boost::regex> e = cache->get(pattern(n));
+      if(!e || (e->str() != pattern(n)) || !boost::regex_search("xx key" + std::to_string(n) + "=value", *e))
+         ++*bad;
+   }
+}
+
+int cpp_main( int , char* [] )
+{
+   {
+      boost::regex_cache cache;
+      std::shared_ptr<const boost::regex> a = cache.get("a+b");
+      std::shared_ptr<const boost::regex> b = cache.get(std::string("a+b"));
+      std::shared_ptr<const boost::regex> c = cache.get("a+b", boost::regex::icase);
+      BOOST_CHECK(a == b);
+      BOOST_CHECK(a != c);
+      BOOST_CHECK(c->flags() & boost::regex::icase);
+      BOOST_CHECK(cache.size() == 2);
+      boost::regex_cache_statistics stats = cache.statistics();
+      BOOST_CHECK(stats.hits == 1);
+      BOOST_CHECK(stats.misses == 2);
+      BOOST_CHECK(stats.evictions == 0);
+      BOOST_CHECK(stats.bytes == a->memory_usage() + c->memory_usage());
+
+      // invalid expressions throw, and aren't cached:
+      BOOST_CHECK_THROW(cache.get("a(b"), boost::regex_error);
+      BOOST_CHECK(cache.size() == 2);
+
+      cache.clear();
+      BOOST_CHECK(cache.size() == 0);
+      BOOST_CHECK(cache.statistics().bytes == 0);
+      // callers keep what they were given:
+      BOOST_CHECK(boost::regex_match("aab", *a));
+      BOOST_CHECK(cache.get("a+b") != a);
+   }
+   {
+      // one shard, so the order of eviction is exact:
+      boost::regex_cache cache(3, 0, 1);
+      std::shared_ptr<const boost::regex> first = cache.get("one");
+      cache.get("two");
+      cache.get("three");
+      cache.get("one");
+      cache.get("four");
+      BOOST_CHECK(cache.size() == 3);
+      BOOST_CHECK(cache.statistics().evictions == 1);
+      BOOST_CHECK(cache.get("one") == first);
+      BOOST_CHECK(cache.statistics().misses == 4);
+      cache.get("two");
+      BOOST_CHECK(cache.statistics().misses == 5);
+   }
+   {
+      // a byte limit which only has room for a couple of expressions:
+      std::size_t bytes = boost::regex("x").memory_usage();
+      boost::regex_cache cache(0, 2 * bytes + bytes / 2, 1);
+      for(int i = 0; i < 10; ++i)
+         cache.get(pattern(i));
+      boost::regex_cache_statistics stats = cache.statistics();
+      BOOST_CHECK(stats.size >= 1);
+      BOOST_CHECK(stats.size < 10);
+      BOOST_CHECK(stats.bytes <= 2 * bytes + bytes / 2);
+      BOOST_CHECK(stats.evictions == 10 - stats.size);
+   }
+   {
+      // small enough that threads keep evicting each other's expressions:
+      boost::regex_cache cache(pattern_count / 2, 0, 4);
+      std::vector<int> bad(8, 0);
+      std::vector<std::thread> threads;
+      for(std::size_t i = 0; i < bad.size(); ++i)
+         threads.push_back(std::thread(lookup, &cache, static_cast<int>(i), &bad[i]));
+      for(std::size_t i = 0; i < threads.size(); ++i)
+         threads[i].join();
+      for(std::size_t i = 0; i < bad.size(); ++i)
+         BOOST_CHECK(bad[i] == 0);
+      boost::regex_cache_statistics stats = cache.statistics();
+      BOOST_CHECK(stats.hits + stats.misses == bad.size() * iterations);
+      BOOST_CHECK(stats.size <= pattern_count / 2);
+      BOOST_CHECK(stats.size == cache.size());
+   }
+   return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_corpus.hpp"
+#include <string>
+#include <vector>
+
+#ifdef BOOST_INTEL
+#pragma warning(disable:1418 981 983 383)
+#endif
+
+//
+// Every expression in the set must be found exactly where regex_search
+// finds it on its own, when using match_linear:
+//
+void check_set(const boost::regex_set& s, const std::string& text, boost::match_flag_type flags)
+{
+   std::vector<std::size_t> ids;
+   std::vector<boost::ssub_match> matches;
+   bool found = boost::regex_search(text, ids, s, flags);
+   BOOST_CHECK(found == !ids.empty());
+   BOOST_CHECK(boost::regex_search(text.begin(), text.end(), matches, s, flags) == found);
+   BOOST_CHECK(matches.size() == s.size());
+   std::size_t j = 0;
+   for(std::size_t i = 0; i < s.size(); ++i)
+   {
+      boost::smatch what;
+      bool expected = boost::regex_search(text, what, s[i], flags | boost::match_linear);
+      bool listed = (j < ids.size()) && (ids[j] == i);
+      if(listed)
+         ++j;
+      if(expected != listed)
+      {
+         BOOST_ERROR(("Wrong result for expression " + s[i].str() + " against \"" + text + "\"").c_str());
+         continue;
+      }
+      if(expected && ((matches[i].first != what[0].first) || (matches[i].second != what[0].second) || !matches[i].matched))
+         BOOST_ERROR(("Wrong match for expression " + s[i].str() + " against \"" + text + "\"").c_str());
+      if(!expected && matches[i].matched)
+         BOOST_ERROR(("Unexpected match for expression " + s[i].str() + " against \"" + text + "\"").c_str());
+   }
+   BOOST_CHECK(j == ids.size());
+}
+
+void test_wide()
+{
+#if !defined(BOOST_NO_WREGEX)
+   boost::wregex_set s;
+   BOOST_CHECK(s.add(L"abc") == 0);
+   BOOST_CHECK(s.add(L"d+e") == 1);
+   BOOST_CHECK(s.add(std::wstring(L"^x")) == 2);
+   std::vector<std::size_t> ids;
+   BOOST_CHECK(boost::regex_search(L"xabc dde", ids, s));
+   BOOST_CHECK(ids.size() == 3);
+   BOOST_CHECK(!boost::regex_search(L"ab d e", ids, s));
+   BOOST_CHECK(ids.empty());
+#endif
+}
+
+int cpp_main( int , char* [] )
+{
+   boost::regex_set s;
+   BOOST_CHECK(s.empty());
+   for(std::size_t i = 0; i < corpus_pattern_count; ++i)
+      BOOST_CHECK(s.add(corpus_patterns[i]) == i);
+   BOOST_CHECK(s.size() == corpus_pattern_count);
+   BOOST_CHECK_THROW(s.add("a(b"), boost::regex_error);
+   BOOST_CHECK(s.size() == corpus_pattern_count);
+
+   static const boost::match_flag_type flags[] =
+   {
+      boost::match_default,
+      boost::match_continuous,
+      boost::match_not_dot_newline | boost::match_not_bol | boost::match_not_bow,
+      boost::match_not_null,
+   };
+   for(std::size_t t = 0; t < corpus_text_count; ++t)
+   {
+      for(std::size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); ++f)
+         check_set(s, corpus_texts[t], flags[f]);
+   }
+
+   // a copy doesn't see changes made to the original:
+   boost::regex_set copy(s);
+   s.add("nothing else");
+   BOOST_CHECK(copy.size() + 1 == s.size());
+   std::vector<std::size_t> ids;
+   BOOST_CHECK(boost::regex_search("nothing else", ids, s));
+   BOOST_CHECK(ids.back() == copy.size());
+   BOOST_CHECK(boost::regex_search("nothing else", ids, copy));
+   BOOST_CHECK(ids.back() < copy.size());
+   check_set(copy, "2024-01-31 error: the the timeout after 300ms", boost::match_default);
+
+   // branches and starts are restricted just as they are for match_linear:
+   boost::regex_set branches;
+   branches.add("($)+");
+   branches.add("\\w(?:($))+");
+   branches.add("((\n+?)*)\\<");
+   branches.add("x*[^b]");
+   branches.add("a{0,2}?b");
+   static const char* const branch_texts[] = { "", "a", "bx bb\n\nb", "xxa", "aab", "xb" };
+   for(std::size_t t = 0; t < sizeof(branch_texts) / sizeof(branch_texts[0]); ++t)
+   {
+      check_set(branches, branch_texts[t], boost::match_default);
+      check_set(branches, branch_texts[t], boost::match_any);
+   }
+
+   // \A is where the search starts, whatever comes before:
+   boost::regex_set start;
+   start.add("\\`x");
+   std::string yx("yx");
+   BOOST_CHECK(boost::regex_search(yx.begin() + 1, yx.end(), ids, start, boost::match_prev_avail));
+
+   // many expressions at once:
+   boost::regex_set many;
+   for(int i = 0; i < 1000; ++i)
+      many.add("id=" + std::to_string(i) + "\\b");
+   BOOST_CHECK(boost::regex_search("x id=12 id=999 id=1000", ids, many));
+   BOOST_CHECK(ids.size() == 2);
+   BOOST_CHECK(ids[0] == 12);
+   BOOST_CHECK(ids[1] == 999);
+
+   many.clear();
+   BOOST_CHECK(many.empty());
+   BOOST_CHECK(!boost::regex_search("id=1", ids, many));
+
+   test_wide();
+   return 0;
+}
@@ -210,3 +210,120 @@ void test_nosubs()
 }
 
 
+
+void test_literal_prefix()
+{
+   using namespace boost::regex_constants;
+   //
+   // expressions which start with a literal string are searched for
+   // using that string:
+   //
+   TEST_REGEX_SEARCH("abc", perl, "xxabcxxabc", match_default, make_array(2, 5, -2, 7, 10, -2, -2));
+   TEST_REGEX_SEARCH("abcd", perl, "abcabcabcd", match_default, make_array(6, 10, -2, -2));
+   TEST_REGEX_SEARCH("abab", perl, "abababab", match_default, make_array(0, 4, -2, 4, 8, -2, -2));
+   TEST_REGEX_SEARCH("aab", perl, "aaaaab", match_default, make_array(3, 6, -2, -2));
+   TEST_REGEX_SEARCH("abc", perl, "ab", match_default, make_array(-2, -2));
+   TEST_REGEX_SEARCH("abc", perl, "", match_default, make_array(-2, -2));
+   TEST_REGEX_SEARCH("abc\\d", perl, "abcxabc1", match_default, make_array(4, 8, -2, -2));
+   TEST_REGEX_SEARCH("abc+", perl, "abxabcccx", match_default, make_array(3, 8, -2, -2));
+   TEST_REGEX_SEARCH("(ab)(cd)e", perl, "abcdabcde", match_default, make_array(4, 9, 4, 6, 6, 8, -2, -2));
+   TEST_REGEX_SEARCH("(?:ab)cd+", perl, "abcabcdd", match_default, make_array(3, 8, -2, -2));
+   TEST_REGEX_SEARCH("abc(d|e)", boost::regex::extended, "abcfabce", match_default, make_array(4, 8, 7, 8, -2, -2));
+   TEST_REGEX_SEARCH("a.c", literal, "abca.c", match_default, make_array(3, 6, -2, -2));
+   // case insensitive prefixes:
+   TEST_REGEX_SEARCH("abc", perl|icase, "xxABcxaBC", match_default, make_array(2, 5, -2, 6, 9, -2, -2));
+   TEST_REGEX_SEARCH("(?i)abc", perl, "xxABCx", match_default, make_array(2, 5, -2, -2));
+   TEST_REGEX_SEARCH("(?i:ab)c", perl, "xABcxabC abc", match_default, make_array(1, 4, -2, 9, 12, -2, -2));
+   TEST_REGEX_SEARCH("ab(?i)cd", perl, "ABcd abCD", match_default, make_array(5, 9, -2, -2));
+   TEST_REGEX_SEARCH("(?-i)ab", perl|icase, "ABab", match_default, make_array(2, 4, -2, -2));
+   // partial matches may start with part of the prefix:
+   TEST_REGEX_SEARCH("abc", perl, "xxab", match_default|match_partial, make_array(2, 4, -2, -2));
+   TEST_REGEX_SEARCH("abcd", perl, "xxabcx", match_default|match_partial, make_array(-2, -2));
+   //
+   // literals which every match must contain, but which aren't at the start:
+   //
+   TEST_REGEX_SEARCH("\\d{4}-\\d\\d.*timeout=\\d+", perl, "2024-01 x timeout=30", match_default, make_array(0, 20, -2, -2));
+   TEST_REGEX_SEARCH("\\d{4}-\\d\\d.*timeout=\\d+", perl, "2024-01 x timeout 30", match_default, make_array(-2, -2));
+   TEST_REGEX_SEARCH("\\w+@example\\.com", perl, "mail bob@example.com now", match_default, make_array(5, 20, -2, -2));
+   TEST_REGEX_SEARCH("[a-z]{2}XYZ", perl, "abcdefXYZ abXYZ", match_default, make_array(4, 9, -2, 10, 15, -2, -2));
+   TEST_REGEX_SEARCH("a.cXYZ", perl, "abcXYZaxcXYZ", match_default, make_array(0, 6, -2, 6, 12, -2, -2));
+   TEST_REGEX_SEARCH("\\d+ERROR", perl|icase, "12error 3ERROR", match_default, make_array(0, 7, -2, 8, 14, -2, -2));
+   TEST_REGEX_SEARCH("x?(abc)\\d", perl, "abcabc1", match_default, make_array(3, 7, 3, 6, -2, -2));
+   TEST_REGEX_SEARCH("\\d(abc|def)", perl, "1def", match_default, make_array(0, 4, 1, 4, -2, -2));
+   TEST_REGEX_SEARCH("\\d(?=abc)", perl, "1abc", match_default, make_array(0, 1, -2, -2));
+   TEST_REGEX_SEARCH("(a)\\1xyz", perl, "aaxyz", match_default, make_array(0, 5, 0, 1, -2, -2));
+   TEST_REGEX_SEARCH("\\d+abc", perl, "12ab", match_default|match_partial, make_array(0, 4, -2, -2));
+}
+
+void test_lazy_dfa()
+{
+   using namespace boost::regex_constants;
+   //
+   // the DFA finds where each match starts, the sub-expressions are
+   // then filled in as usual:
+   //
+   TEST_REGEX_SEARCH("(a|ab)(c|bcd)(d*)", perl, "abcd", match_default|match_dfa, make_array(0, 4, 0, 1, 1, 4, 4, 4, -2, -2));
+   TEST_REGEX_SEARCH("x{2,4}y", perl, "xxxxxy", match_default|match_dfa, make_array(1, 6, -2, -2));
+   TEST_REGEX_SEARCH("[a-c]+z", perl, "abcabcz", match_default|match_dfa, make_array(0, 7, -2, -2));
+   TEST_REGEX_SEARCH("(ab)+", perl, "xababab", match_default|match_dfa, make_array(1, 7, 5, 7, -2, -2));
+   TEST_REGEX_SEARCH("a.*b", perl, "xxaxbxxbx", match_default|match_dfa, make_array(2, 8, -2, -2));
+   TEST_REGEX_SEARCH("a[^x]{0,3}z|b", perl, "abbz", match_default|match_dfa, make_array(0, 4, -2, -2));
+   TEST_REGEX_SEARCH("a*", perl, "baa", match_default|match_dfa, make_array(0, 0, -2, 1, 3, -2, 3, 3, -2, -2));
+   TEST_REGEX_SEARCH("foo\\d+|bar\\s", perl, "foo bar", match_default|match_dfa, make_array(-2, -2));
+   TEST_REGEX_SEARCH("a(?i)b", perl, "aB Ab ab", match_default|match_dfa, make_array(0, 2, -2, 6, 8, -2, -2));
+   TEST_REGEX_SEARCH("a.c", perl, "a\nc abc", match_not_dot_newline|match_dfa, make_array(4, 7, -2, -2));
+   // zero width assertions:
+   TEST_REGEX_SEARCH("\\bcat\\b", perl, "concat cat", match_default|match_dfa, make_array(7, 10, -2, -2));
+   TEST_REGEX_SEARCH("^foo$", perl, "bar\nfoo\nx", match_default|match_dfa, make_array(4, 7, -2, -2));
+   TEST_REGEX_SEARCH("^foo$", perl, "bar\nfoo\nx", match_single_line|match_dfa, make_array(-2, -2));
+   TEST_REGEX_SEARCH("b$", perl, "ab\r\ncd", match_default|match_dfa, make_array(1, 2, -2, -2));
+   TEST_REGEX_SEARCH("\\<\\w+\\>", perl, "  hi there", match_default|match_dfa, make_array(2, 4, -2, 5, 10, -2, -2));
+   TEST_REGEX_SEARCH("\\Aab|cd\\z", perl, "abcdab", match_default|match_dfa, make_array(0, 2, -2, -2));
+   TEST_REGEX_SEARCH("\\Bb\\w", perl, "ab bc abc", match_default|match_dfa, make_array(7, 9, -2, -2));
+   // a repeat which matches nothing ends the repeat, as when backtracking:
+   TEST_REGEX_SEARCH("a(b|c?)+d", perl, "abcd", match_default|match_dfa, make_array(0, 4, 3, 3, -2, -2));
+   TEST_REGEX_SEARCH("(a*)*", perl, "b", match_default|match_dfa, make_array(0, 0, 0, 0, -2, 1, 1, 1, 1, -2, -2));
+   // anchored searches:
+   TEST_REGEX_SEARCH("ab+", perl, "abbbc", match_continuous|match_dfa, make_array(0, 4, -2, -2));
+   TEST_REGEX_SEARCH("ab+", perl, "xabbbc", match_continuous|match_dfa, make_array(-2, -2));
+   // expressions the DFA can't handle are matched in the usual way:
+   TEST_REGEX_SEARCH("(a)\\1", perl, "xaa", match_default|match_dfa, make_array(1, 3, 1, 2, -2, -2));
+   TEST_REGEX_SEARCH("a(?=b)", perl, "acab", match_default|match_dfa, make_array(2, 3, -2, -2));
+   TEST_REGEX_SEARCH("(ab){2}", perl, "abxabab", match_default|match_dfa, make_array(3, 7, 5, 7, -2, -2));
+   TEST_REGEX_SEARCH("a*", perl, "baa", match_not_null|match_dfa, make_array(1, 3, -2, -2));
+}
+
+void test_pike_vm()
+{
+   using namespace boost::regex_constants;
+   //
+   // the Pike VM finds the same matches and sub-expressions as backtracking:
+   //
+   TEST_REGEX_SEARCH("(a|ab)(c|bcd)(d*)", perl, "abcd", match_default|match_linear, make_array(0, 4, 0, 1, 1, 4, 4, 4, -2, -2));
+   TEST_REGEX_SEARCH("(a+)(b)?", perl, "xxaab", match_default|match_linear, make_array(2, 5, 2, 4, 4, 5, -2, -2));
+   TEST_REGEX_SEARCH("(?:(a)|b)+", perl, "ab", match_default|match_linear, make_array(0, 2, 0, 1, -2, -2));
+   TEST_REGEX_SEARCH("(a|b)*?c", perl, "abac", match_default|match_linear, make_array(0, 4, 2, 3, -2, -2));
+   TEST_REGEX_SEARCH("x(.*)y", perl, "axbcybby", match_default|match_linear, make_array(1, 8, 2, 7, -2, -2));
+   TEST_REGEX_SEARCH("(a)|b", perl, "b", match_default|match_linear, make_array(0, 1, -1, -1, -2, -2));
+   TEST_REGEX_SEARCH("^(\\w+)\\s+(\\w+)$", perl, "hi there\nab cd", match_default|match_linear, make_array(0, 8, 0, 2, 3, 8, -2, 9, 14, 9, 11, 12, 14, -2, -2));
+   TEST_REGEX_SEARCH("a(?i)(b)", perl, "aB Ab ab", match_default|match_linear, make_array(0, 2, 1, 2, -2, 6, 8, 7, 8, -2, -2));
+   // a repeat which matches nothing ends the repeat, as when backtracking:
+   TEST_REGEX_SEARCH("a(b|c?)+d", perl, "abcd", match_default|match_linear, make_array(0, 4, 3, 3, -2, -2));
+   TEST_REGEX_SEARCH("a(b+|((c)*))+d", perl, "abcd", match_default|match_linear, make_array(0, 4, 3, 3, 3, 3, 2, 3, -2, -2));
+   TEST_REGEX_SEARCH("(a*)*", perl, "b", match_default|match_linear, make_array(0, 0, 0, 0, -2, 1, 1, 1, 1, -2, -2));
+   // zero width assertions, and null matches:
+   TEST_REGEX_SEARCH("\\B", perl, "ab", match_default|match_linear, make_array(1, 1, -2, -2));
+   TEST_REGEX_SEARCH("c??\\>[^a]", perl, "ca\n", match_default|match_linear, make_array(2, 3, -2, -2));
+   TEST_REGEX_SEARCH("a*", perl, "baa", match_not_null|match_linear, make_array(1, 3, -2, -2));
+   TEST_REGEX_SEARCH("ab+", perl, "xabbbc", match_continuous|match_linear, make_array(-2, -2));
+   TEST_REGEX_SEARCH("(a|ab)(c|bcd)(d*)", perl, "abcd", match_default|match_dfa|match_linear, make_array(0, 4, 0, 1, 1, 4, 4, 4, -2, -2));
+   // branches are only taken where the start maps allow, as when backtracking:
+   TEST_REGEX_SEARCH("\\w(?:($))+", perl, "a", match_default|match_linear, make_array(-2, -2));
+   TEST_REGEX_SEARCH("(?:($))*", perl, "", match_default|match_linear, make_array(0, 0, -1, -1, -2, -2));
+   TEST_REGEX_SEARCH("((\n+?)*)\\<", perl, "bx bb\n\nb", match_default|match_linear, make_array(0, 0, 0, 0, -1, -1, -2, 3, 3, 3, 3, -1, -1, -2, 5, 7, 5, 7, 5, 7, -2, 7, 7, 7, 7, -1, -1, -2, -2));
+   // and repeats aren't greedy when any match will do:
+   TEST_REGEX_SEARCH("x*[^b]", perl, "xxa", match_any|match_linear, make_array(0, 1, -2, 1, 2, -2, 2, 3, -2, -2));
+   // expressions the Pike VM can't handle are matched in the usual way:
+   TEST_REGEX_SEARCH("(a)\\1", perl, "xaa", match_default|match_linear, make_array(1, 3, 1, 2, -2, -2));
+   TEST_REGEX_SEARCH("(ab){2}", perl, "abxabab", match_default|match_linear, make_array(3, 7, 5, 7, -2, -2));
+}
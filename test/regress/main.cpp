@@ -71,6 +71,9 @@ void run_tests()
    RUN_TESTS(test_fast_repeats2);
    RUN_TESTS(test_independent_subs);
    RUN_TESTS(test_nosubs);
+   RUN_TESTS(test_literal_prefix);
+   RUN_TESTS(test_lazy_dfa);
+   RUN_TESTS(test_pike_vm);
    RUN_TESTS(test_conditionals);
    RUN_TESTS(test_options);
    RUN_TESTS(test_options2);
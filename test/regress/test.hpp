@@ -277,6 +277,9 @@ void test_fast_repeats2();
 void test_tricky_cases2();
 void test_independent_subs();
 void test_nosubs();
+void test_literal_prefix();
+void test_lazy_dfa();
+void test_pike_vm();
 void test_conditionals();
 void test_options();
 void test_options2();
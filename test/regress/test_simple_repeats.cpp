@@ -436,6 +436,17 @@ void test_fast_repeats2()
    TEST_REGEX_SEARCH("A[^B]*?B[xac]*?C", perl, "AxBx", match_default|match_partial|match_not_dot_null, make_array(0, 4, -2, -2));
    TEST_REGEX_SEARCH("A[^B]*?B[xac[.ae.]]*?C", perl, "AxBxxxx", match_default|match_partial|match_not_dot_null, make_array(0, 7, -2, -2));
    TEST_REGEX_SEARCH("A[^B]*?B[xac[.ae.]]*?C", perl, "AxBx", match_default|match_partial|match_not_dot_null, make_array(0, 4, -2, -2));
+   //
+   // Leading repeats with a non-zero minimum, and searches which have to
+   // skip over long runs of characters which can't start a match:
+   //
+   TEST_REGEX_SEARCH("\\d+", perl, "the quick brown fox jumps over 42 lazy dogs", match_default, make_array(31, 33, -2, -2));
+   TEST_REGEX_SEARCH("\\d+", perl, "the quick brown fox jumps over the lazy dog", match_default, make_array(-2, -2));
+   TEST_REGEX_SEARCH("[A-Z]+ \\d", perl, "the quick brown fox jumps over THE 1 lazy dog", match_default, make_array(31, 36, -2, -2));
+   TEST_REGEX_SEARCH("[xy]{2,}z", perl, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaxaaayyzaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaxyzaa", match_default, make_array(37, 40, -2, 71, 74, -2, -2));
+   TEST_REGEX_SEARCH("[qxz]", perl, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaz", match_default, make_array(65, 66, -2, -2));
+   TEST_REGEX_SEARCH("[b-gmq-tx]y", perl, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaxaaaaaaaaaaaaaty", match_default, make_array(72, 74, -2, -2));
+   TEST_REGEX_SEARCH("x*y", perl, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaxxy", match_default, make_array(41, 44, -2, -2));
 
 
 }
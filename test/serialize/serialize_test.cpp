@@ -0,0 +1,139 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <boost/regex.hpp>
+#include <boost/detail/lightweight_main.hpp>
+#include "../test_corpus.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef BOOST_INTEL
+#pragma warning(disable:1418 981 983 383)
+#endif
+
+void check_same(const boost::regex& original, const boost::regex& loaded)
+{
+   BOOST_CHECK(loaded.str() == original.str());
+   BOOST_CHECK(loaded.flags() == original.flags());
+   BOOST_CHECK(loaded.mark_count() == original.mark_count());
+   BOOST_CHECK(loaded.memory_usage() != 0);
+   for(std::size_t i = 0; (original.flags() & boost::regex::save_subexpression_location) && (i < original.mark_count()); ++i)
+   {
+      BOOST_CHECK(loaded.subexpression(i).first - loaded.expression() == original.subexpression(i).first - original.expression());
+      BOOST_CHECK(loaded.subexpression(i).second - loaded.expression() == original.subexpression(i).second - original.expression());
+   }
+   static const boost::match_flag_type flags[] =
+   {
+      boost::match_default,
+      boost::match_not_dot_newline | boost::match_not_bol,
+      boost::match_linear,
+      boost::match_dfa,
+   };
+   for(std::size_t t = 0; t < corpus_text_count; ++t)
+   {
+      for(std::size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); ++f)
+      {
+         std::string text(corpus_texts[t]);
+         check_same_matches(all_matches(text, loaded, flags[f]), all_matches(text, original, flags[f]), original);
+      }
+   }
+}
+
+void test_wide()
+{
+#if !defined(BOOST_NO_WREGEX)
+   boost::wregex e(L"(?<x>[[:alpha:]]+)-\\d+");
+   std::vector<unsigned char> blob;
+   boost::save_regex(e, blob);
+   boost::wregex loaded;
+   BOOST_CHECK(boost::load_regex(loaded, &blob[0], blob.size()) == blob.size());
+   boost::wsmatch what;
+   std::wstring text(L"  abc-123 ");
+   BOOST_CHECK(boost::regex_search(text, what, loaded));
+   BOOST_CHECK(what[L"x"] == L"abc");
+   // a narrow expression can't be loaded as a wide one:
+   std::vector<unsigned char> narrow;
+   boost::save_regex(boost::regex("abc"), narrow);
+   BOOST_CHECK_THROW(boost::load_regex(loaded, &narrow[0], narrow.size()), std::runtime_error);
+   BOOST_CHECK(boost::regex_search(text, what, loaded));
+#endif
+}
+
+int cpp_main( int , char* [] )
+{
+   // save everything into one blob, then load it all back:
+   std::vector<unsigned char> blob;
+   std::vector<boost::regex> originals;
+   std::vector<std::size_t> offsets;
+   for(std::size_t i = 0; i < corpus_pattern_count; ++i)
+   {
+      originals.push_back(boost::regex(corpus_patterns[i]));
+      offsets.push_back(blob.size());
+      boost::save_regex(originals.back(), blob);
+   }
+   std::size_t position = 0;
+   for(std::size_t i = 0; i < originals.size(); ++i)
+   {
+      boost::regex loaded;
+      BOOST_CHECK(position == offsets[i]);
+      position += boost::load_regex(loaded, &blob[position], blob.size() - position);
+      check_same(originals[i], loaded);
+   }
+   BOOST_CHECK(position == blob.size());
+
+   // named sub-expressions survive:
+   boost::regex e;
+   blob.clear();
+   boost::save_regex(boost::regex("(?<user>\\w+)@(?<host>\\w+)\\.com"), blob);
+   boost::load_regex(e, &blob[0], blob.size());
+   boost::smatch what;
+   std::string text("mail bob@example.com");
+   BOOST_CHECK(boost::regex_search(text, what, e));
+   BOOST_CHECK(what["user"] == "bob");
+   BOOST_CHECK(what["host"] == "example");
+
+   // other flavours of expression:
+   boost::regex icase("ABC|d[e-g]+", boost::regex::icase);
+   boost::regex posix("(a|ab)(bc|c)", boost::regex::extended | boost::regex::save_subexpression_location);
+   std::vector<unsigned char> more;
+   boost::save_regex(icase, more);
+   std::size_t second = more.size();
+   boost::save_regex(posix, more);
+   boost::load_regex(e, &more[0], more.size());
+   check_same(icase, e);
+   boost::load_regex(e, &more[second], more.size() - second);
+   check_same(posix, e);
+
+   // invalid expressions can't be saved:
+   BOOST_CHECK(boost::regex().memory_usage() == 0);
+   BOOST_CHECK_THROW(boost::save_regex(boost::regex(), more), std::logic_error);
+   BOOST_CHECK_THROW(boost::save_regex(boost::regex("a(b", boost::regex::no_except), more), std::logic_error);
+
+   // damaged data is refused, and leaves the expression as it was:
+   std::vector<unsigned char> bad(more.begin(), more.begin() + second);
+   BOOST_CHECK_THROW(boost::load_regex(e, &bad[0], bad.size() - 1), std::runtime_error);
+   BOOST_CHECK_THROW(boost::load_regex(e, &bad[0], 10), std::runtime_error);
+   for(std::size_t i = 0; i < bad.size(); i += 7)
+   {
+      bad[i] ^= 0x20;
+      BOOST_CHECK_THROW(boost::load_regex(e, &bad[0], bad.size()), std::runtime_error);
+      bad[i] ^= 0x20;
+   }
+   BOOST_CHECK(boost::load_regex(e, &bad[0], bad.size()) == bad.size());
+   check_same(icase, e);
+   // a blob from a different version of the format:
+   bad[4] ^= 1;
+   BOOST_CHECK_THROW(boost::load_regex(e, &bad[0], bad.size()), std::runtime_error);
+   check_same(icase, e);
+
+   test_wide();
+   return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ *
+ * Copyright (c) 2026
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE:        test_corpus.hpp
+  *   VERSION:     see <boost/version.hpp>
+  *   DESCRIPTION: Expressions and texts shared by the tests which check
+  *                that some other way of matching finds the same thing
+  *                as plain regex_search and regex_match, along with the
+  *                comparisons they make.
+  */
+
+#ifndef BOOST_REGEX_TEST_CORPUS_HPP
+#define BOOST_REGEX_TEST_CORPUS_HPP
+
+#include <boost/regex.hpp>
+#include "test_macros.hpp"
+#include <string>
+#include <vector>
+
+//
+// Between them these use each way of finding where a match can start,
+// and most of what can go in an expression: null matches, back-references,
+// recursion, lookaround, independent sub-expressions and verbs:
+//
+static const char* const corpus_patterns[] =
+{
+   "abc",
+   "a+b",
+   "Chrome/\\d+",                   // required literal
+   "abcab",
+   "\\<error\\>",
+   "(?i)WARN(ING)?",
+   "^\\d{4}-\\d\\d-\\d\\d",
+   "^https?://[^/]*\\.example\\.com/",
+   "iPhone|Android",                // start map
+   "(?<user>\\w+)@(?<host>\\w+)\\.com",
+   "(\\w+)/(\\d+)\\.(\\d+)",
+   "x*",                            // can match nothing
+   "$",
+   "(a|ab)(c|bcd)(d*)",
+   "b\\B",
+   "\\bthe\\b",
+   "timeout after \\d+ms$",
+   ".*timeout",
+   "[[:space:]]+$",
+   "[^a-f0-9]+",
+   ".z",
+   "a{2,3}?c",
+   "(a*)*c",
+   "(\\w+) \\1",                    // back-references
+   "(a+)\\1",
+   "(?<word>\\w)\\w*\\k<word>",
+   "\\((?:[^()]|(?R))*\\)",         // recursion
+   "q(?=u)",                        // lookaround
+   "(?<=t)he",
+   "(?<=id=)\\d+",
+   "(?>a+)b",
+   "\\`ab",
+   "a\\Kb",
+   "(*COMMIT)ab|ac",
+};
+
+static const char* const corpus_texts[] =
+{
+   "",
+   "x",
+   "ab",
+   "abc",
+   "abcd",
+   "xxx",
+   "2024-01-31 error: the the timeout after 300ms",
+   "aaab warning from bob@example.com  ",
+   "mail bob@example.com or the the f(a(b)c)",
+   "f(a(b)c) quit the error-free Warn",
+   "((a)(b(c)))d",
+   "abcd\nxz\n",
+   "zzz bbc",
+   "aaac abba xyzzy",
+   "aaaa foo abcab",
+   "key=value; other=thing",
+   "https://www.example.com/path?id=12345",
+   "Mozilla/5.0 (Windows NT 10.0) Chrome/120.0 Safari/537.36",
+   "Mozilla/5.0 (iPhone; CPU iPhone OS 17_0) Version/17.0",
+   "curl/7.68.0",
+   "xyz 42",
+};
+
+static const std::size_t corpus_pattern_count = sizeof(corpus_patterns) / sizeof(corpus_patterns[0]);
+static const std::size_t corpus_text_count = sizeof(corpus_texts) / sizeof(corpus_texts[0]);
+
+//
+// Whether two sets of results for the same text say the same thing,
+// down to where each sub-expression starts and ends:
+//
+template <class BidiIterator>
+bool same_match(const boost::match_results<BidiIterator>& a, const boost::match_results<BidiIterator>& b)
+{
+   if(a.size() != b.size())
+      return false;
+   if(a.empty())
+      return true;
+   if((a.prefix().first != b.prefix().first) || (a.suffix().second != b.suffix().second))
+      return false;
+   for(std::size_t i = 0; i < a.size(); ++i)
+   {
+      if((a[i].matched != b[i].matched) || (a[i].first != b[i].first) || (a[i].second != b[i].second))
+         return false;
+   }
+   return true;
+}
+
+//
+// Every match regex_iterator finds, in order:
+//
+template <class BidiIterator>
+std::vector<boost::match_results<BidiIterator> > all_matches(boost::regex_iterator<BidiIterator> i)
+{
+   return std::vector<boost::match_results<BidiIterator> >(i, boost::regex_iterator<BidiIterator>());
+}
+inline std::vector<boost::smatch> all_matches(const std::string& text, const boost::regex& e, boost::match_flag_type flags = boost::match_default)
+{
+   return all_matches(boost::sregex_iterator(text.begin(), text.end(), e, flags));
+}
+
+template <class BidiIterator>
+void check_same_matches(const std::vector<boost::match_results<BidiIterator> >& found, const std::vector<boost::match_results<BidiIterator> >& expected, const boost::regex& e)
+{
+   if(found.size() != expected.size())
+      BOOST_ERROR(("Found " + std::to_string(found.size()) + " matches for " + e.str() + " rather than " + std::to_string(expected.size())).c_str());
+   for(std::size_t i = 0; (i < found.size()) && (i < expected.size()); ++i)
+   {
+      if(!same_match(found[i], expected[i]))
+      {
+         BOOST_ERROR(("Wrong match " + std::to_string(i) + " for " + e.str()).c_str());
+         return;
+      }
+   }
+}
+
+//
+// Passing extra along to regex_search and regex_match, whether it's a
+// match context, a budget or somewhere to put statistics, mustn't
+// change what they find:
+//
+template <class Extra>
+void check_unchanged(const boost::regex& e, const std::string& text, Extra& extra)
+{
+   boost::smatch what, expected;
+   bool found = boost::regex_search(text, expected, e);
+   BOOST_CHECK(boost::regex_search(text, what, e, extra) == found);
+   if(found && !same_match(what, expected))
+      BOOST_ERROR(("Wrong search result for " + e.str() + " against \"" + text + "\"").c_str());
+   BOOST_CHECK(boost::regex_search(text, e, extra) == found);
+   found = boost::regex_match(text, expected, e);
+   BOOST_CHECK(boost::regex_match(text, what, e, extra) == found);
+   if(found && !same_match(what, expected))
+      BOOST_ERROR(("Wrong match result for " + e.str() + " against \"" + text + "\"").c_str());
+   BOOST_CHECK(boost::regex_match(text, e, extra) == found);
+}
+
+#endif